@@ -0,0 +1,175 @@
+/*
+    GRAPE is Romain's Audio Plug-in Extension classes for the JUCE framework
+
+    Copyright (c) 2018 Romain Clement
+
+    MIT License    
+    
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+    
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+ */
+
+//==============================================================================
+
+#include "BenchmarkRunner.h"
+#include <algorithm>
+#include <iostream>
+#include <numeric>
+
+//==============================================================================
+
+namespace grape {
+namespace benchmarks {
+
+//==============================================================================
+
+static juce::String formatDuration (double nanoseconds)
+{
+    if (nanoseconds >= 1.0e9)
+        return juce::String (nanoseconds / 1.0e9, 2) + " s";
+
+    if (nanoseconds >= 1.0e6)
+        return juce::String (nanoseconds / 1.0e6, 2) + " ms";
+
+    if (nanoseconds >= 1.0e3)
+        return juce::String (nanoseconds / 1.0e3, 2) + " us";
+
+    return juce::String (nanoseconds, 1) + " ns";
+}
+
+//==============================================================================
+
+BenchmarkRunner::BenchmarkRunner (const juce::String& filter)
+    : mFilter (filter)
+{
+
+}
+
+BenchmarkRunner::~BenchmarkRunner()
+{
+
+}
+
+//==============================================================================
+
+bool BenchmarkRunner::isEnabled (const juce::String& name) const
+{
+    return mFilter.isEmpty() || name.containsIgnoreCase (mFilter);
+}
+
+const BenchmarkRunner::Result* BenchmarkRunner::run (const juce::String& name,
+                                                     const juce::NamedValueSet& parameters,
+                                                     int numSamples,
+                                                     int batchSize,
+                                                     Body body,
+                                                     Body setup)
+{
+    if (!isEnabled (name))
+        return nullptr;
+
+    numSamples = juce::jmax (numSamples, 1);
+    batchSize = juce::jmax (batchSize, 1);
+
+    const auto nanosecondsPerTick = 1.0e9 / static_cast<double> (juce::Time::getHighResolutionTicksPerSecond());
+
+    std::vector<double> samples;
+    samples.reserve (static_cast<size_t> (numSamples));
+
+    for (int s = 0; s < numSamples; ++s)
+    {
+        if (setup != nullptr)
+            setup();
+
+        const auto startTicks = juce::Time::getHighResolutionTicks();
+
+        for (int b = 0; b < batchSize; ++b)
+            body();
+
+        const auto elapsedTicks = juce::Time::getHighResolutionTicks() - startTicks;
+        samples.push_back (static_cast<double> (elapsedTicks) * nanosecondsPerTick / batchSize);
+    }
+
+    std::sort (samples.begin(), samples.end());
+
+    Result result;
+    result.name = name;
+    result.parameters = parameters;
+    result.numSamples = numSamples;
+    result.batchSize = batchSize;
+    result.minNanoseconds = samples.front();
+    result.medianNanoseconds = samples[samples.size() / 2];
+    result.meanNanoseconds = std::accumulate (samples.begin(), samples.end(), 0.0) / static_cast<double> (samples.size());
+    result.maxNanoseconds = samples.back();
+
+    juce::String description (name);
+    for (const auto& parameter : parameters)
+        description << " " << parameter.name.toString() << "=" << parameter.value.toString();
+
+    std::cerr << description.paddedRight (' ', 56) << " median "
+              << formatDuration (result.medianNanoseconds).paddedLeft (' ', 10) << "  min "
+              << formatDuration (result.minNanoseconds).paddedLeft (' ', 10) << std::endl;
+
+    mResults.push_back (result);
+    return &mResults.back();
+}
+
+//==============================================================================
+
+juce::var BenchmarkRunner::toVar() const
+{
+    juce::Array<juce::var> benchmarks;
+
+    for (const auto& result : mResults)
+    {
+        auto* parameters = new juce::DynamicObject();
+        for (const auto& parameter : result.parameters)
+            parameters->setProperty (parameter.name, parameter.value);
+
+        auto* benchmark = new juce::DynamicObject();
+        benchmark->setProperty ("name", result.name);
+        benchmark->setProperty ("parameters", juce::var (parameters));
+        benchmark->setProperty ("samples", result.numSamples);
+        benchmark->setProperty ("batch", result.batchSize);
+        benchmark->setProperty ("min_ns", result.minNanoseconds);
+        benchmark->setProperty ("median_ns", result.medianNanoseconds);
+        benchmark->setProperty ("mean_ns", result.meanNanoseconds);
+        benchmark->setProperty ("max_ns", result.maxNanoseconds);
+        benchmarks.add (juce::var (benchmark));
+    }
+
+    auto* root = new juce::DynamicObject();
+    root->setProperty ("format", 1);
+    root->setProperty ("timestamp", juce::Time::getCurrentTime().toISO8601 (true));
+   #if JUCE_DEBUG
+    root->setProperty ("build", "debug");
+   #else
+    root->setProperty ("build", "release");
+   #endif
+    root->setProperty ("benchmarks", benchmarks);
+    return juce::var (root);
+}
+
+juce::String BenchmarkRunner::toJson() const
+{
+    return juce::JSON::toString (toVar());
+}
+
+//==============================================================================
+
+} // namespace benchmarks
+} // namespace grape
@@ -0,0 +1,97 @@
+/*
+    GRAPE is Romain's Audio Plug-in Extension classes for the JUCE framework
+
+    Copyright (c) 2018 Romain Clement
+
+    MIT License    
+    
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+    
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+ */
+
+//==============================================================================
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <functional>
+#include <vector>
+
+//==============================================================================
+
+namespace grape {
+namespace benchmarks {
+
+//==============================================================================
+
+/** Times benchmark bodies and collects the results as JSON.
+
+    Each sample times batchSize consecutive calls of the body, so that calls
+    much shorter than the timer resolution can still be measured; results
+    are reported per call.
+*/
+class BenchmarkRunner
+{
+public:
+    struct Result
+    {
+        juce::String        name;
+        juce::NamedValueSet parameters;
+        int                 numSamples;
+        int                 batchSize;
+        double              minNanoseconds;
+        double              medianNanoseconds;
+        double              meanNanoseconds;
+        double              maxNanoseconds;
+    };
+
+    using Body = std::function<void()>;
+
+public:
+    explicit BenchmarkRunner (const juce::String& filter = juce::String());
+    ~BenchmarkRunner();
+
+public:
+    bool isEnabled (const juce::String& name) const;
+
+    /** Runs body numSamples times batchSize times. The optional setup runs
+        untimed before each sample.
+    */
+    const Result* run (const juce::String& name,
+                       const juce::NamedValueSet& parameters,
+                       int numSamples,
+                       int batchSize,
+                       Body body,
+                       Body setup = nullptr);
+
+    inline const std::vector<Result>& getResults() const { return mResults; }
+
+    juce::var toVar() const;
+    juce::String toJson() const;
+
+private:
+    const juce::String  mFilter;
+    std::vector<Result> mResults;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (BenchmarkRunner)
+};
+
+//==============================================================================
+
+} // namespace benchmarks
+} // namespace grape
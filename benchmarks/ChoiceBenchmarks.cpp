@@ -0,0 +1,126 @@
+/*
+    GRAPE is Romain's Audio Plug-in Extension classes for the JUCE framework
+
+    Copyright (c) 2018 Romain Clement
+
+    MIT License    
+    
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+    
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+ */
+
+//==============================================================================
+
+#include "Benchmarks.h"
+#include <grape/helpers/Helpers.h>
+
+//==============================================================================
+
+namespace grape {
+namespace benchmarks {
+
+//==============================================================================
+
+namespace {
+
+// Keeps the compiler from discarding the conversions
+volatile float valueSink = 0.0f;
+volatile int lengthSink = 0;
+
+const std::array<juce::String, 4> fewLabels { { "Off", "Low", "Medium", "High" } };
+
+constexpr auto fewTable = helpers::makeChoiceTable ("Off", "Low", "Medium", "High");
+static_assert (fewTable.isPerfect(), "");
+
+const std::array<juce::String, 24> manyLabels { {
+    "Major", "Minor", "Dorian", "Phrygian", "Lydian", "Mixolydian",
+    "Locrian", "Harmonic Minor", "Melodic Minor", "Whole Tone", "Chromatic", "Blues",
+    "Pentatonic Major", "Pentatonic Minor", "Hungarian Minor", "Neapolitan", "Enigmatic", "Persian",
+    "Arabic", "Japanese", "Egyptian", "Bebop", "Diminished", "Augmented"
+} };
+
+constexpr auto manyTable = helpers::makeChoiceTable (
+    "Major", "Minor", "Dorian", "Phrygian", "Lydian", "Mixolydian",
+    "Locrian", "Harmonic Minor", "Melodic Minor", "Whole Tone", "Chromatic", "Blues",
+    "Pentatonic Major", "Pentatonic Minor", "Hungarian Minor", "Neapolitan", "Enigmatic", "Persian",
+    "Arabic", "Japanese", "Egyptian", "Bebop", "Diminished", "Augmented");
+static_assert (manyTable.isPerfect(), "");
+
+/** Compares the std::array helpers with their ChoiceTable counterparts on
+    the same labels. Hosts type labels in any case, so lookups use upper
+    case text.
+*/
+template <size_t numLabels,
+          const std::array<juce::String, numLabels>& labels,
+          typename TableType,
+          const TableType& table>
+void runChoiceBenchmark (BenchmarkRunner& runner)
+{
+    juce::StringArray texts;
+    for (const auto& label : labels)
+        texts.add (label.toUpperCase());
+
+    juce::NamedValueSet args;
+    args.set ("labels", static_cast<int> (numLabels));
+
+    const auto batchSize = 1000;
+    auto next = 0;
+
+    runner.run ("choiceLabelToIndex/array", args, 20, batchSize,
+                [&texts, &next]
+                {
+                    valueSink = helpers::choiceLabelToIndex<static_cast<int> (numLabels), labels> (texts[next]);
+                    next = (next + 1) % texts.size();
+                });
+
+    runner.run ("choiceLabelToIndex/table", args, 20, batchSize,
+                [&texts, &next]
+                {
+                    valueSink = helpers::choiceLabelToIndex<TableType, table> (texts[next]);
+                    next = (next + 1) % texts.size();
+                });
+
+    runner.run ("choiceIndexToLabel/array", args, 20, batchSize,
+                [&next]
+                {
+                    lengthSink = helpers::choiceIndexToLabel<static_cast<int> (numLabels), labels> (static_cast<float> (next)).length();
+                    next = (next + 1) % static_cast<int> (numLabels);
+                });
+
+    runner.run ("choiceIndexToLabel/table", args, 20, batchSize,
+                [&next]
+                {
+                    lengthSink = helpers::choiceIndexToLabel<TableType, table> (static_cast<float> (next)).length();
+                    next = (next + 1) % static_cast<int> (numLabels);
+                });
+}
+
+} // namespace
+
+//==============================================================================
+
+void runChoiceBenchmarks (BenchmarkRunner& runner, const Options&)
+{
+    runChoiceBenchmark<4, fewLabels, helpers::ChoiceTable<4>, fewTable> (runner);
+    runChoiceBenchmark<24, manyLabels, helpers::ChoiceTable<24>, manyTable> (runner);
+}
+
+//==============================================================================
+
+} // namespace benchmarks
+} // namespace grape
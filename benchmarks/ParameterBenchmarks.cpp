@@ -0,0 +1,93 @@
+/*
+    GRAPE is Romain's Audio Plug-in Extension classes for the JUCE framework
+
+    Copyright (c) 2018 Romain Clement
+
+    MIT License    
+    
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+    
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+ */
+
+//==============================================================================
+
+#include "Benchmarks.h"
+#include "TestProcessor.h"
+#include <memory>
+
+//==============================================================================
+
+namespace grape {
+namespace benchmarks {
+
+//==============================================================================
+
+void runParameterBenchmarks (BenchmarkRunner& runner, const Options& options)
+{
+    const auto parameterCounts = options.quick ? juce::Array<int> { 10, 100 }
+                                               : juce::Array<int> { 10, 100, 1000, 5000 };
+
+    for (const auto numParameters : parameterCounts)
+    {
+        host::TestProcessor processor (numParameters);
+        auto& parameters = processor.getParameterManager();
+
+        juce::NamedValueSet args;
+        args.set ("parameters", numParameters);
+
+        // Keep the total work per sample roughly constant across sizes
+        const auto batchSize = juce::jmax (1, 1000 / numParameters);
+
+        juce::Random random (numParameters);
+        const auto randomise = [&parameters, &random]
+        {
+            for (int i = 0; i < parameters.getNumParameters(); ++i)
+                parameters.getParameterByIndex (i)->setValueNotifyingHost (random.nextFloat());
+        };
+
+        runner.run ("ParameterManager::resetAll", args, 20, 1,
+                    [&parameters] { parameters.resetAll(); },
+                    randomise);
+
+        randomise();
+
+        runner.run ("ParameterManager::toXml", args, 20, batchSize,
+                    [&parameters] { std::unique_ptr<juce::XmlElement> xml (parameters.toXml()); });
+
+        std::unique_ptr<juce::XmlElement> xml (parameters.toXml());
+        parameters.resetAll();
+
+        runner.run ("ParameterManager::fromXml", args, 20, batchSize,
+                    [&parameters, &xml] { parameters.fromXml (*xml); });
+    }
+
+    host::TestProcessor processor;
+    auto& settings = processor.getSettingManager();
+    auto counter = 0;
+
+    runner.run ("SettingManager::getSetting", {}, 20, 1000,
+                [&settings] { juce::ignoreUnused (settings.getSetting ("oversampling")); });
+
+    runner.run ("SettingManager::setSetting", {}, 20, 1000,
+                [&settings, &counter] { settings.setSetting ("oversampling", ++counter % 4); });
+}
+
+//==============================================================================
+
+} // namespace benchmarks
+} // namespace grape
@@ -0,0 +1,184 @@
+/*
+    GRAPE is Romain's Audio Plug-in Extension classes for the JUCE framework
+
+    Copyright (c) 2018 Romain Clement
+
+    MIT License    
+    
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+    
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+ */
+
+//==============================================================================
+
+#include "Benchmarks.h"
+#include "PresetLibrary.h"
+#include "TestProcessor.h"
+#include <algorithm>
+#include <iostream>
+#include <memory>
+
+//==============================================================================
+
+namespace grape {
+namespace benchmarks {
+
+//==============================================================================
+
+static const char* const constructAndRestoreName = "PresetManager::constructAndRestore";
+
+//==============================================================================
+
+void runPresetBenchmarks (BenchmarkRunner& runner, const Options& options)
+{
+    static const juce::StringArray names {
+        "PresetManager::findPresets",
+        "PresetManager::getAllPresets",
+        "PresetManager::loadPreset",
+        "PresetManager::loadNextPreset",
+        "PresetManager::checkPresetChanged",
+        constructAndRestoreName
+    };
+
+    // Writing the libraries takes far longer than the benchmarks themselves
+    if (std::none_of (names.begin(), names.end(), [&runner] (const juce::String& name) { return runner.isEnabled (name); }))
+        return;
+
+    const auto librarySizes = options.quick ? juce::Array<int> { 1000, 10000 }
+                                            : juce::Array<int> { 1000, 10000, 100000 };
+
+    for (const auto numPresets : librarySizes)
+    {
+        std::unique_ptr<PresetLibrary> library;
+        juce::MemoryBlock session;
+
+        {
+            host::TestProcessor processor;
+
+            std::cerr << "Writing " << numPresets << " presets..." << std::endl;
+            library.reset (new PresetLibrary (processor.getPresetManager().getUserPresetsLocation(),
+                                              processor.getParameterManager(),
+                                              numPresets));
+
+            processor.getPresetManager().loadPreset (library->getPreset (numPresets / 2));
+            processor.getStateInformation (session);
+        }
+
+        juce::NamedValueSet args;
+        args.set ("presets", numPresets);
+
+        // What a host does for each instance of a saved session. No other
+        // instance is alive, so each sample also starts a new catalogue.
+        runner.run (constructAndRestoreName, args, 20, 1,
+                    [&session]
+                    {
+                        host::TestProcessor processor;
+                        processor.setStateInformation (session.getData(), static_cast<int> (session.getSize()));
+                    });
+
+        host::TestProcessor processor;
+        auto& presets = processor.getPresetManager();
+        auto& parameters = processor.getParameterManager();
+
+        // Fewer samples for the scans of the largest libraries
+        const auto numScans = numPresets >= 100000 ? 3 : 10;
+
+        runner.run ("PresetManager::findPresets", args, numScans, 1,
+                    [&presets] { presets.refreshPresets(); });
+
+        runner.run ("PresetManager::getAllPresets", args, 20, 1,
+                    [&presets] { juce::ignoreUnused (presets.getAllPresets()); });
+
+        const auto allPresets = presets.getAllPresets();
+        jassert (allPresets.size() >= numPresets);
+        auto next = 0;
+
+        runner.run ("PresetManager::loadPreset", args, 20, 50,
+                    [&presets, &allPresets, &next]
+                    {
+                        presets.loadPreset (allPresets.getReference (next));
+                        next = (next + 1) % allPresets.size();
+                    });
+
+        // Navigation rebuilds its order on first use: start each sample from
+        // the first preset with the order already in place
+        runner.run ("PresetManager::loadNextPreset", args, 20, 50,
+                    [&presets] { presets.loadNextPreset(); },
+                    [&presets, &allPresets]
+                    {
+                        presets.loadPreset (allPresets.getReference (0));
+                        juce::ignoreUnused (presets.getCurrentPresetPosition());
+                    });
+
+        runner.run ("PresetManager::checkPresetChanged", args, 20, 1000,
+                    [&presets] { presets.checkPresetChanged(); });
+
+        auto* parameter = parameters.getParameterByIndex (0);
+        auto edit = 0;
+
+        runner.run ("PresetManager::checkPresetChanged/edited", args, 200, 1,
+                    [&presets] { presets.checkPresetChanged(); },
+                    [parameter, &edit]
+                    {
+                        parameter->setValueNotifyingHost ((++edit % 100) / 100.0f);
+                    });
+    }
+}
+
+bool checkRestoreScaling (const BenchmarkRunner& runner, double maxRatio)
+{
+    const BenchmarkRunner::Result* smallest = nullptr;
+    const BenchmarkRunner::Result* largest = nullptr;
+
+    for (const auto& result : runner.getResults())
+    {
+        if (result.name != constructAndRestoreName)
+            continue;
+
+        const int numPresets = result.parameters["presets"];
+
+        if (smallest == nullptr || numPresets < static_cast<int> (smallest->parameters["presets"]))
+            smallest = &result;
+
+        if (largest == nullptr || numPresets > static_cast<int> (largest->parameters["presets"]))
+            largest = &result;
+    }
+
+    if (smallest == nullptr || smallest == largest)
+    {
+        std::cerr << "FAILED: " << constructAndRestoreName << " needs at least two library sizes" << std::endl;
+        return false;
+    }
+
+    // Minimums are the least sensitive to scheduling noise
+    const auto ratio = largest->minNanoseconds / smallest->minNanoseconds;
+    const auto passed = ratio <= maxRatio;
+
+    std::cerr << (passed ? "PASSED: " : "FAILED: ") << constructAndRestoreName << " takes "
+              << juce::String (ratio, 2) << "x as long with "
+              << largest->parameters["presets"].toString() << " presets as with "
+              << smallest->parameters["presets"].toString() << " (limit "
+              << juce::String (maxRatio, 1) << "x)" << std::endl;
+
+    return passed;
+}
+
+//==============================================================================
+
+} // namespace benchmarks
+} // namespace grape
@@ -0,0 +1,112 @@
+/*
+    GRAPE is Romain's Audio Plug-in Extension classes for the JUCE framework
+
+    Copyright (c) 2018 Romain Clement
+
+    MIT License    
+    
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+    
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+ */
+
+//==============================================================================
+
+#include "PresetLibrary.h"
+
+//==============================================================================
+
+namespace grape {
+namespace benchmarks {
+
+//==============================================================================
+
+constexpr int PresetLibrary::presetsPerFolder;
+constexpr int PresetLibrary::foldersPerBank;
+
+//==============================================================================
+
+PresetLibrary::PresetLibrary (const juce::File& userPresetsLocation,
+                              parameters::ParameterManager& parameterManager,
+                              int numPresets)
+    : mLocation (userPresetsLocation)
+    , mNumPresets (numPresets)
+{
+    write (parameterManager);
+}
+
+PresetLibrary::~PresetLibrary()
+{
+    for (const auto& folder : mBankFolders)
+        folder.deleteRecursively();
+}
+
+//==============================================================================
+
+presets::Preset PresetLibrary::getPreset (int index) const
+{
+    jassert (index >= 0 && index < mNumPresets);
+    return presets::Preset (getPresetFile (index), getBankName (index));
+}
+
+//==============================================================================
+
+juce::String PresetLibrary::getBankName (int index)
+{
+    const auto bankIndex = index / (presetsPerFolder * foldersPerBank);
+    return "Benchmark Bank " + juce::String (bankIndex + 1).paddedLeft ('0', 3);
+}
+
+juce::File PresetLibrary::getPresetFile (int index) const
+{
+    const auto folderIndex = (index / presetsPerFolder) % foldersPerBank;
+
+    return mLocation.getChildFile (getBankName (index))
+                    .getChildFile ("Sub " + juce::String (folderIndex + 1).paddedLeft ('0', 2))
+                    .getChildFile ("Preset " + juce::String (index + 1).paddedLeft ('0', 6) + ".xml");
+}
+
+void PresetLibrary::write (parameters::ParameterManager& parameterManager)
+{
+    const auto numParameters = parameterManager.getNumParameters();
+    juce::Random random (static_cast<juce::int64> (mNumPresets));
+
+    for (int i = 0; i < mNumPresets; ++i)
+    {
+        const auto file = getPresetFile (i);
+
+        if (i % (presetsPerFolder * foldersPerBank) == 0)
+            mBankFolders.add (mLocation.getChildFile (getBankName (i)));
+
+        if (i % presetsPerFolder == 0)
+            file.getParentDirectory().createDirectory();
+
+        for (int p = 0; p < juce::jmin (numParameters, 4); ++p)
+            parameterManager.getParameterByIndex (p)->setValueNotifyingHost (random.nextFloat());
+
+        auto preset = getPreset (i);
+        preset.replaceState (parameterManager.copyState());
+        preset.saveToFile();
+    }
+
+    parameterManager.resetAll();
+}
+
+//==============================================================================
+
+} // namespace benchmarks
+} // namespace grape
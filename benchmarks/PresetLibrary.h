@@ -0,0 +1,83 @@
+/*
+    GRAPE is Romain's Audio Plug-in Extension classes for the JUCE framework
+
+    Copyright (c) 2018 Romain Clement
+
+    MIT License    
+    
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+    
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+ */
+
+//==============================================================================
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <grape/parameters/ParameterManager.h>
+#include <grape/presets/Preset.h>
+
+//==============================================================================
+
+namespace grape {
+namespace benchmarks {
+
+//==============================================================================
+
+/** A synthetic user preset library, written on construction and deleted on
+    destruction.
+
+    Presets are spread over banks of presetsPerBank files, each split into
+    nested sub folders, and hold the current parameter state with a few
+    values varied per preset so that they have distinct content hashes.
+*/
+class PresetLibrary
+{
+public:
+    PresetLibrary (const juce::File& userPresetsLocation,
+                   parameters::ParameterManager&,
+                   int numPresets);
+    ~PresetLibrary();
+
+public:
+    static constexpr int presetsPerFolder = 100;
+    static constexpr int foldersPerBank = 10;
+
+    inline int getNumPresets() const { return mNumPresets; }
+    inline const juce::Array<juce::File>& getBankFolders() const { return mBankFolders; }
+
+    /** Returns the preset at index, unloaded. */
+    presets::Preset getPreset (int index) const;
+
+private:
+    static juce::String getBankName (int index);
+    juce::File getPresetFile (int index) const;
+    void write (parameters::ParameterManager&);
+
+private:
+    const juce::File        mLocation;
+    const int               mNumPresets;
+    juce::Array<juce::File> mBankFolders;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PresetLibrary)
+};
+
+//==============================================================================
+
+} // namespace benchmarks
+} // namespace grape
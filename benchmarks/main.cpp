@@ -0,0 +1,95 @@
+/*
+    GRAPE is Romain's Audio Plug-in Extension classes for the JUCE framework
+
+    Copyright (c) 2018 Romain Clement
+
+    MIT License    
+    
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+    
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+ */
+
+//==============================================================================
+
+#include <JuceHeader.h>
+#include "Benchmarks.h"
+#include <iostream>
+
+//==============================================================================
+
+static void printUsage()
+{
+    std::cerr << "Usage: grape_benchmarks [--json <file>] [--filter <text>] [--quick] [--check]" << std::endl
+              << std::endl
+              << "  --json <file>    Write the results to <file> instead of stdout" << std::endl
+              << "  --filter <text>  Only run benchmarks whose name contains <text>" << std::endl
+              << "  --quick          Only use the smallest libraries and parameter sets" << std::endl
+              << "  --check          Fail if session restore time grows with the library size" << std::endl;
+}
+
+int main (int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    juce::File jsonFile;
+    juce::String filter;
+    grape::benchmarks::Options options;
+    auto check = false;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const juce::String arg (argv[i]);
+
+        if (arg == "--json" && i + 1 < argc)
+            jsonFile = juce::File::getCurrentWorkingDirectory().getChildFile (argv[++i]);
+        else if (arg == "--filter" && i + 1 < argc)
+            filter = argv[++i];
+        else if (arg == "--quick")
+            options.quick = true;
+        else if (arg == "--check")
+            check = true;
+        else
+        {
+            printUsage();
+            return 1;
+        }
+    }
+
+    grape::benchmarks::BenchmarkRunner runner (filter);
+    grape::benchmarks::runChoiceBenchmarks (runner, options);
+    grape::benchmarks::runParameterBenchmarks (runner, options);
+    grape::benchmarks::runPresetBenchmarks (runner, options);
+
+    const auto json = runner.toJson();
+
+    if (jsonFile == juce::File())
+        std::cout << json << std::endl;
+    else if (!jsonFile.replaceWithText (json + "\n"))
+    {
+        std::cerr << "Cannot write " << jsonFile.getFullPathName() << std::endl;
+        return 1;
+    }
+
+    // Generous: a scan of even the smallest library costs far more than this
+    const auto maxRestoreRatio = 3.0;
+
+    if (check && !grape::benchmarks::checkRestoreScaling (runner, maxRestoreRatio))
+        return 2;
+
+    return 0;
+}
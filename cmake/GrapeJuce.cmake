@@ -0,0 +1,105 @@
+# Builds the JUCE 5 modules GRAPE depends on as a static library, grape_juce.
+#
+# JUCE 5 has no CMake support of its own, so each module's unity source is
+# compiled directly against cmake/JuceLibraryCode/AppConfig.h. The modules are
+# taken from GRAPE_JUCE_DIR when set, or fetched at GRAPE_JUCE_TAG otherwise.
+
+include (FetchContent)
+
+set (GRAPE_JUCE_DIR "" CACHE PATH "JUCE 5 checkout to build against (fetched when empty)")
+set (GRAPE_JUCE_REPOSITORY "https://github.com/juce-framework/JUCE.git" CACHE STRING "JUCE repository to fetch")
+set (GRAPE_JUCE_TAG "5.4.7" CACHE STRING "JUCE tag to fetch")
+
+if (GRAPE_JUCE_DIR)
+    set (GRAPE_JUCE_SOURCE_DIR "${GRAPE_JUCE_DIR}")
+else ()
+    FetchContent_Declare (juce
+        GIT_REPOSITORY  "${GRAPE_JUCE_REPOSITORY}"
+        GIT_TAG         "${GRAPE_JUCE_TAG}"
+        GIT_SHALLOW     ON
+    )
+
+    FetchContent_GetProperties (juce)
+    if (NOT juce_POPULATED)
+        # Populate only: JUCE 5 ships no CMakeLists.txt to add
+        FetchContent_Populate (juce)
+    endif ()
+
+    set (GRAPE_JUCE_SOURCE_DIR "${juce_SOURCE_DIR}")
+endif ()
+
+if (NOT EXISTS "${GRAPE_JUCE_SOURCE_DIR}/modules/juce_core/juce_core.h")
+    message (FATAL_ERROR "JUCE modules not found in '${GRAPE_JUCE_SOURCE_DIR}'")
+endif ()
+
+set (GRAPE_JUCE_MODULES
+    juce_core
+    juce_events
+    juce_data_structures
+    juce_audio_basics
+    juce_graphics
+    juce_gui_basics
+    juce_gui_extra
+    juce_audio_processors
+)
+
+set (GRAPE_JUCE_SOURCES)
+foreach (module IN LISTS GRAPE_JUCE_MODULES)
+    set (moduleSource "${GRAPE_JUCE_SOURCE_DIR}/modules/${module}/${module}")
+
+    if (APPLE AND EXISTS "${moduleSource}.mm")
+        list (APPEND GRAPE_JUCE_SOURCES "${moduleSource}.mm")
+    else ()
+        list (APPEND GRAPE_JUCE_SOURCES "${moduleSource}.cpp")
+    endif ()
+endforeach ()
+
+add_library (grape_juce STATIC ${GRAPE_JUCE_SOURCES})
+
+target_include_directories (grape_juce
+    PUBLIC
+        "${CMAKE_CURRENT_LIST_DIR}/JuceLibraryCode"
+        "${GRAPE_JUCE_SOURCE_DIR}/modules"
+)
+
+target_compile_definitions (grape_juce
+    PUBLIC
+        JUCE_APP_CONFIG_HEADER="AppConfig.h"
+        $<$<CONFIG:Debug>:DEBUG=1 _DEBUG=1>
+)
+
+# Third-party code: keep the build log about GRAPE
+if (MSVC)
+    target_compile_options (grape_juce PRIVATE /w)
+else ()
+    target_compile_options (grape_juce PRIVATE -w)
+endif ()
+
+if (APPLE)
+    target_link_libraries (grape_juce
+        PUBLIC
+            "-framework Accelerate"
+            "-framework AudioToolbox"
+            "-framework Carbon"
+            "-framework Cocoa"
+            "-framework CoreAudio"
+            "-framework CoreAudioKit"
+            "-framework CoreMIDI"
+            "-framework IOKit"
+            "-framework QuartzCore"
+    )
+elseif (UNIX)
+    find_package (Threads REQUIRED)
+    find_package (Freetype REQUIRED)
+    find_package (X11 REQUIRED)
+
+    target_link_libraries (grape_juce
+        PUBLIC
+            Threads::Threads
+            Freetype::Freetype
+            X11::X11
+            X11::Xext
+            ${CMAKE_DL_LIBS}
+            rt
+    )
+endif ()
@@ -0,0 +1,53 @@
+/*
+    Global JUCE module settings for the standalone GRAPE build (unit tests,
+    benchmarks and stress harness). Plug-in projects using GRAPE keep their
+    own Projucer-generated AppConfig.h.
+ */
+
+#pragma once
+
+//==============================================================================
+
+#define JUCE_GLOBAL_MODULE_SETTINGS_INCLUDED    1
+
+#define JUCE_MODULE_AVAILABLE_juce_audio_basics         1
+#define JUCE_MODULE_AVAILABLE_juce_audio_processors     1
+#define JUCE_MODULE_AVAILABLE_juce_core                 1
+#define JUCE_MODULE_AVAILABLE_juce_data_structures      1
+#define JUCE_MODULE_AVAILABLE_juce_events               1
+#define JUCE_MODULE_AVAILABLE_juce_graphics             1
+#define JUCE_MODULE_AVAILABLE_juce_gui_basics           1
+#define JUCE_MODULE_AVAILABLE_juce_gui_extra            1
+
+#ifndef JUCE_STANDALONE_APPLICATION
+ #define JUCE_STANDALONE_APPLICATION    1
+#endif
+
+#ifndef JUCE_DISPLAY_SPLASH_SCREEN
+ #define JUCE_DISPLAY_SPLASH_SCREEN     0
+#endif
+
+#ifndef JUCE_REPORT_APP_USAGE
+ #define JUCE_REPORT_APP_USAGE          0
+#endif
+
+//==============================================================================
+// Headless build: no plug-in hosting, browser, network or X11 extensions
+
+#define JUCE_PLUGINHOST_VST             0
+#define JUCE_PLUGINHOST_VST3            0
+#define JUCE_PLUGINHOST_AU              0
+#define JUCE_PLUGINHOST_LADSPA          0
+
+#define JUCE_WEB_BROWSER                0
+#define JUCE_USE_CURL                   0
+#define JUCE_LOAD_CURL_SYMBOLS_LAZILY   0
+
+#define JUCE_USE_XRANDR                 0
+#define JUCE_USE_XINERAMA               0
+#define JUCE_USE_XSHM                   0
+#define JUCE_USE_XRENDER                0
+#define JUCE_USE_XCURSOR                0
+
+#define JUCE_MODAL_LOOPS_PERMITTED      1
+#define JUCE_CHECK_MEMORY_LEAKS         1
@@ -0,0 +1,26 @@
+/*
+    JuceHeader.h for the standalone GRAPE build, equivalent to the one the
+    Projucer generates for a plug-in project using GRAPE.
+ */
+
+#pragma once
+
+#include "AppConfig.h"
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <juce_audio_processors/juce_audio_processors.h>
+#include <juce_core/juce_core.h>
+#include <juce_data_structures/juce_data_structures.h>
+#include <juce_events/juce_events.h>
+#include <juce_graphics/juce_graphics.h>
+#include <juce_gui_basics/juce_gui_basics.h>
+#include <juce_gui_extra/juce_gui_extra.h>
+
+#if ! JUCE_DONT_DECLARE_PROJECTINFO
+namespace ProjectInfo
+{
+    const char* const  projectName    = "GRAPE";
+    const char* const  versionString  = "0.1.0";
+    const int          versionNumber  = 0x100;
+}
+#endif
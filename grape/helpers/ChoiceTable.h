@@ -0,0 +1,210 @@
+/*
+    GRAPE is Romain's Audio Plug-in Extension classes for the JUCE framework
+
+    Copyright (c) 2018 Romain Clement
+
+    MIT License    
+    
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+    
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+ */
+
+//==============================================================================
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <cmath>
+
+//==============================================================================
+
+namespace grape {
+namespace helpers {
+
+//==============================================================================
+
+// Choice labels with a case-insensitive (ASCII) perfect hash, built at
+// compile time. Without a perfect seed lookups scan; check isPerfect().
+template <size_t numLabels>
+class ChoiceTable
+{
+public:
+    static constexpr size_t numChoices = numLabels;
+
+public:
+    constexpr ChoiceTable (const char* const (&labels)[numLabels]) noexcept
+    {
+        for (size_t i = 0; i < numLabels; ++i)
+            mLabels[i] = labels[i];
+
+        for (juce::uint32 seed = 0; seed < maxSeeds; ++seed)
+        {
+            if (buildSlots (seed))
+            {
+                mSeed = seed;
+                mIsPerfect = true;
+                return;
+            }
+        }
+    }
+
+public:
+    constexpr size_t size() const noexcept { return numLabels; }
+    constexpr bool isPerfect() const noexcept { return mIsPerfect; }
+
+    constexpr const char* getLabel (int index) const noexcept
+    {
+        return (index >= 0 && static_cast<size_t> (index) < numLabels) ? mLabels[index] : "";
+    }
+
+    int indexOf (const char* text) const noexcept
+    {
+        if (mIsPerfect)
+        {
+            const auto slot = mSlots[hashLabel (text, mSeed) & (tableSize - 1)];
+            return (slot >= 0 && equalsIgnoreCase (mLabels[slot], text)) ? slot : -1;
+        }
+
+        for (size_t i = 0; i < numLabels; ++i)
+            if (equalsIgnoreCase (mLabels[i], text))
+                return static_cast<int> (i);
+
+        return -1;
+    }
+
+    int indexOf (const juce::String& text) const noexcept
+    {
+        return indexOf (text.toRawUTF8());
+    }
+
+private:
+    static constexpr size_t roundUpToPowerOfTwo (size_t n) noexcept
+    {
+        size_t result = 1;
+        while (result < n)
+            result <<= 1;
+
+        return result;
+    }
+
+    static constexpr size_t tableSize = roundUpToPowerOfTwo (numLabels * 4);
+    static constexpr juce::uint32 maxSeeds = 1024;
+
+    static constexpr char toLower (char c) noexcept
+    {
+        return (c >= 'A' && c <= 'Z') ? static_cast<char> (c - 'A' + 'a') : c;
+    }
+
+    static constexpr juce::uint32 hashLabel (const char* text, juce::uint32 seed) noexcept
+    {
+        juce::uint32 hash = 2166136261u ^ (seed * 0x9e3779b9u);
+
+        for (; *text != 0; ++text)
+        {
+            hash ^= static_cast<juce::uint8> (toLower (*text));
+            hash *= 16777619u;
+        }
+
+        hash ^= hash >> 16;
+        hash *= 0x85ebca6bu;
+        hash ^= hash >> 13;
+        return hash;
+    }
+
+    static constexpr bool equalsIgnoreCase (const char* a, const char* b) noexcept
+    {
+        for (; *a != 0 && *b != 0; ++a, ++b)
+            if (toLower (*a) != toLower (*b))
+                return false;
+
+        return *a == *b;
+    }
+
+    constexpr bool buildSlots (juce::uint32 seed) noexcept
+    {
+        for (size_t i = 0; i < tableSize; ++i)
+            mSlots[i] = -1;
+
+        for (size_t i = 0; i < numLabels; ++i)
+        {
+            const auto slot = hashLabel (mLabels[i], seed) & (tableSize - 1);
+            if (mSlots[slot] >= 0)
+                return false;
+
+            mSlots[slot] = static_cast<juce::int16> (i);
+        }
+
+        return true;
+    }
+
+private:
+    const char*     mLabels[numLabels] {};
+    juce::int16     mSlots[tableSize] {};
+    juce::uint32    mSeed = 0;
+    bool            mIsPerfect = false;
+};
+
+template <typename... Labels>
+constexpr ChoiceTable<sizeof... (Labels)> makeChoiceTable (const Labels&... labels) noexcept
+{
+    return ChoiceTable<sizeof... (Labels)> ({ static_cast<const char*> (labels)... });
+}
+
+//==============================================================================
+
+template <typename TableType, const TableType& table>
+inline juce::String choiceIndexToLabel (float value)
+{
+    // Converted once, so each call only copies a reference-counted string
+    static const auto labels = []
+    {
+        std::array<juce::String, TableType::numChoices> strings;
+        for (size_t i = 0; i < strings.size(); ++i)
+            strings[i] = juce::String::fromUTF8 (table.getLabel (static_cast<int> (i)));
+
+        return strings;
+    }();
+
+    const int index = static_cast<int> (std::floor (value));
+    if (index >= 0 && static_cast<size_t> (index) < labels.size())
+    {
+        return labels[static_cast<size_t> (index)];
+    }
+
+    jassert ("Invalid parameter choice index");
+    return juce::String();
+}
+
+template <typename TableType, const TableType& table>
+inline float choiceLabelToIndex (const juce::String& text)
+{
+    const auto index = table.indexOf (text);
+    if (index >= 0)
+    {
+        return static_cast<float> (index);
+    }
+
+    jassert ("Invalid parameter choice label");
+    return 0.0f;
+}
+
+//==============================================================================
+
+} // namespace helpers
+} // namespace grape
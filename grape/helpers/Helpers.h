@@ -29,6 +29,8 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include <grape/helpers/ChoiceTable.h>
+#include <grape/helpers/ValueFormatter.h>
 #include <array>
 
 //==============================================================================
@@ -46,7 +48,7 @@ inline juce::String floatValueToText (float value)
 
 inline float floatTextToValue (const juce::String& text)
 {
-    return text.getFloatValue();
+    return parseValue (text, ValueFormat());
 }
 
 //==============================================================================
@@ -85,11 +87,26 @@ inline juce::String choiceIndexToLabel (float value)
 }
 
 template< int numSteps, const std::array<juce::String, numSteps>& choices >
-inline float choiceLabelToIndex (juce::String text)
+inline float choiceLabelToIndex (const juce::String& text)
 {
+    static const auto table = []
+    {
+        const char* labels[numSteps];
+        for (int i = 0; i < numSteps; ++i)
+            labels[i] = choices[static_cast<size_t> (i)].toRawUTF8();
+
+        return ChoiceTable<static_cast<size_t> (numSteps)> (labels);
+    }();
+
+    const auto index = table.indexOf (text);
+    if (index >= 0)
+    {
+        return static_cast<float> (index);
+    }
+
+    // The table only folds ASCII case
     for (int i = 0; i < numSteps; ++i) {
-        const juce::String step = choices[i];
-        if (step.equalsIgnoreCase (text))
+        if (choices[i].equalsIgnoreCase (text))
         {
             return static_cast<float> (i);
         }
@@ -101,6 +118,30 @@ inline float choiceLabelToIndex (juce::String text)
 
 //==============================================================================
 
+inline bool replaceFileAtomically (const juce::File& file, const void* data, size_t numBytes)
+{
+    // Named after a .tmp sibling so that scans for the target's extension
+    // never pick up a write in progress
+    const juce::TemporaryFile tempFile (file.getSiblingFile (file.getFileName() + ".tmp"),
+                                        juce::TemporaryFile::useHiddenFile);
+
+    {
+        juce::FileOutputStream output (tempFile.getFile());
+        if (!output.openedOk() || !output.write (data, numBytes))
+            return false;
+
+        // FileOutputStream::flush() syncs the file to disk before the rename
+        output.flush();
+        if (output.getStatus().failed())
+            return false;
+    }
+
+    // The TemporaryFile's own target is the .tmp sibling, so move it here
+    return tempFile.getFile().moveFileTo (file);
+}
+
+//==============================================================================
+
 } // namespace helpers
 } // namespace grape
 
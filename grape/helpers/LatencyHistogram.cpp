@@ -0,0 +1,147 @@
+/*
+    GRAPE is Romain's Audio Plug-in Extension classes for the JUCE framework
+
+    Copyright (c) 2018 Romain Clement
+
+    MIT License    
+    
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+    
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+ */
+
+//==============================================================================
+
+#include <grape/helpers/LatencyHistogram.h>
+
+//==============================================================================
+
+namespace grape {
+namespace helpers {
+
+//==============================================================================
+
+static int getBucketIndex (juce::uint64 ticks)
+{
+    auto index = 0;
+    while (ticks > 1 && index < LatencyHistogram::numBuckets - 1)
+    {
+        ticks >>= 1;
+        ++index;
+    }
+
+    return index;
+}
+
+static double ticksToMicroseconds (juce::int64 ticks)
+{
+    return juce::Time::highResolutionTicksToSeconds (ticks) * 1.0e6;
+}
+
+//==============================================================================
+
+constexpr int LatencyHistogram::numBuckets;
+
+LatencyHistogram::LatencyHistogram()
+{
+    reset();
+}
+
+LatencyHistogram::~LatencyHistogram()
+{
+
+}
+
+//==============================================================================
+
+void LatencyHistogram::record (juce::int64 ticks)
+{
+    const auto value = juce::jmax (ticks, static_cast<juce::int64> (0));
+    mBuckets[static_cast<size_t> (getBucketIndex (static_cast<juce::uint64> (value)))]
+        .fetch_add (1, std::memory_order_relaxed);
+
+    auto currentMax = mMaxTicks.load (std::memory_order_relaxed);
+    while (value > currentMax
+           && !mMaxTicks.compare_exchange_weak (currentMax, value, std::memory_order_relaxed))
+    {
+    }
+}
+
+void LatencyHistogram::reset()
+{
+    for (auto& bucket : mBuckets)
+        bucket.store (0, std::memory_order_relaxed);
+
+    mMaxTicks.store (0, std::memory_order_relaxed);
+}
+
+juce::int64 LatencyHistogram::getCount() const
+{
+    juce::int64 count = 0;
+    for (const auto& bucket : mBuckets)
+        count += bucket.load (std::memory_order_relaxed);
+
+    return count;
+}
+
+double LatencyHistogram::getMaxMicroseconds() const
+{
+    return ticksToMicroseconds (mMaxTicks.load (std::memory_order_relaxed));
+}
+
+double LatencyHistogram::getPercentileMicroseconds (double percentile) const
+{
+    const auto count = getCount();
+    if (count == 0)
+        return 0.0;
+
+    const auto target = static_cast<juce::int64> (std::ceil (juce::jlimit (0.0, 100.0, percentile) / 100.0 * count));
+    juce::int64 accumulated = 0;
+
+    for (int i = 0; i < numBuckets; ++i)
+    {
+        accumulated += mBuckets[static_cast<size_t> (i)].load (std::memory_order_relaxed);
+        if (accumulated >= target)
+        {
+            const auto upperBound = (i == numBuckets - 1)
+                ? mMaxTicks.load (std::memory_order_relaxed)
+                : juce::jmin (static_cast<juce::int64> (2) << i, mMaxTicks.load (std::memory_order_relaxed));
+            return ticksToMicroseconds (upperBound);
+        }
+    }
+
+    return getMaxMicroseconds();
+}
+
+//==============================================================================
+
+LatencyHistogram::ScopedMeasurement::ScopedMeasurement (LatencyHistogram& histogram)
+    : mHistogram (histogram)
+    , mStartTicks (juce::Time::getHighResolutionTicks())
+{
+
+}
+
+LatencyHistogram::ScopedMeasurement::~ScopedMeasurement()
+{
+    mHistogram.record (juce::Time::getHighResolutionTicks() - mStartTicks);
+}
+
+//==============================================================================
+
+} // namespace helpers
+} // namespace grape
@@ -0,0 +1,65 @@
+/*
+    GRAPE is Romain's Audio Plug-in Extension classes for the JUCE framework
+
+    Copyright (c) 2018 Romain Clement
+
+    MIT License    
+    
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+    
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+ */
+
+//==============================================================================
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+
+#ifndef GRAPE_PLUGIN_MANUFACTURER
+ #ifdef JucePlugin_Manufacturer
+  #define GRAPE_PLUGIN_MANUFACTURER         JucePlugin_Manufacturer
+ #else
+  #define GRAPE_PLUGIN_MANUFACTURER         "GRAPE"
+ #endif
+#endif
+
+#ifndef GRAPE_PLUGIN_NAME
+ #ifdef JucePlugin_Name
+  #define GRAPE_PLUGIN_NAME                 JucePlugin_Name
+ #else
+  #define GRAPE_PLUGIN_NAME                 "GRAPE"
+ #endif
+#endif
+
+#ifndef GRAPE_PLUGIN_MANUFACTURER_CODE
+ #ifdef JucePlugin_ManufacturerCode
+  #define GRAPE_PLUGIN_MANUFACTURER_CODE    JucePlugin_ManufacturerCode
+ #else
+  #define GRAPE_PLUGIN_MANUFACTURER_CODE    0x47727065 // 'Grpe'
+ #endif
+#endif
+
+#ifndef GRAPE_PLUGIN_CODE
+ #ifdef JucePlugin_PluginCode
+  #define GRAPE_PLUGIN_CODE                 JucePlugin_PluginCode
+ #else
+  #define GRAPE_PLUGIN_CODE                 0x47726170 // 'Grap'
+ #endif
+#endif
@@ -0,0 +1,322 @@
+/*
+    GRAPE is Romain's Audio Plug-in Extension classes for the JUCE framework
+
+    Copyright (c) 2018 Romain Clement
+
+    MIT License    
+    
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+    
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+ */
+
+//==============================================================================
+
+#include <grape/helpers/Profiler.h>
+
+//==============================================================================
+
+namespace grape {
+namespace helpers {
+
+//==============================================================================
+
+static double ticksToMicroseconds (juce::int64 ticks)
+{
+    return juce::Time::highResolutionTicksToSeconds (ticks) * 1.0e6;
+}
+
+static juce::String escapeJson (const char* text)
+{
+    return juce::String (text).replace ("\\", "\\\\").replace ("\"", "\\\"");
+}
+
+//==============================================================================
+
+constexpr int Profiler::numSites;
+constexpr int Profiler::numEvents;
+constexpr int Profiler::numThreadSlots;
+
+//==============================================================================
+
+Profiler::ScopedTimer::ScopedTimer (const char* name)
+    : mName (name)
+    , mStartTicks (juce::Time::getHighResolutionTicks())
+{
+
+}
+
+Profiler::ScopedTimer::~ScopedTimer()
+{
+    Profiler::getInstance().recordEvent (mName, mStartTicks, juce::Time::getHighResolutionTicks());
+}
+
+//==============================================================================
+
+Profiler::Profiler()
+    : mOriginTicks (juce::Time::getHighResolutionTicks())
+{
+    for (int i = 0; i < numThreadSlots; ++i)
+        mThreads[i].threadIndex = i + 1;
+}
+
+Profiler::~Profiler()
+{
+
+}
+
+//==============================================================================
+
+Profiler& Profiler::getInstance()
+{
+    static Profiler instance;
+    return instance;
+}
+
+void Profiler::recordEvent (const char* name, juce::int64 startTicks, juce::int64 endTicks)
+{
+    auto threadData = getThreadData();
+    if (threadData == nullptr)
+        return;
+
+    auto& data = *threadData;
+    const auto duration = endTicks - startTicks;
+
+    if (auto site = findSite (data, name, false))
+    {
+        const auto count = site->count.load (std::memory_order_relaxed);
+        if (count == 0 || duration < site->minTicks.load (std::memory_order_relaxed))
+            site->minTicks.store (duration, std::memory_order_relaxed);
+        if (count == 0 || duration > site->maxTicks.load (std::memory_order_relaxed))
+            site->maxTicks.store (duration, std::memory_order_relaxed);
+
+        site->totalTicks.fetch_add (duration, std::memory_order_relaxed);
+        site->count.store (count + 1, std::memory_order_release);
+    }
+
+    const auto index = data.numWritten.load (std::memory_order_relaxed);
+    auto& event = data.events[index % static_cast<juce::uint32> (numEvents)];
+    event.name.store (name, std::memory_order_relaxed);
+    event.startTicks.store (startTicks, std::memory_order_relaxed);
+    event.durationTicks.store (duration, std::memory_order_relaxed);
+    data.numWritten.store (index + 1, std::memory_order_release);
+}
+
+void Profiler::incrementCounter (const char* name, juce::int64 delta)
+{
+    auto threadData = getThreadData();
+    if (threadData == nullptr)
+        return;
+
+    if (auto site = findSite (*threadData, name, true))
+    {
+        site->totalTicks.fetch_add (delta, std::memory_order_relaxed);
+        site->count.fetch_add (1, std::memory_order_release);
+    }
+}
+
+juce::Array<Profiler::Stats> Profiler::getStats() const
+{
+    juce::Array<Stats> stats;
+
+    for (const auto& data : mThreads)
+    {
+        for (const auto& site : data.sites)
+        {
+            const auto name = site.name.load (std::memory_order_acquire);
+            const auto count = site.count.load (std::memory_order_acquire);
+
+            if (name == nullptr || count == 0)
+                continue;
+
+            const auto isCounter = site.isCounter.load (std::memory_order_relaxed);
+            const auto toMilliseconds = [isCounter] (juce::int64 value)
+            {
+                return isCounter
+                    ? static_cast<double> (value)
+                    : juce::Time::highResolutionTicksToSeconds (value) * 1.0e3;
+            };
+
+            const auto total = toMilliseconds (site.totalTicks.load (std::memory_order_relaxed));
+            const auto min = toMilliseconds (site.minTicks.load (std::memory_order_relaxed));
+            const auto max = toMilliseconds (site.maxTicks.load (std::memory_order_relaxed));
+
+            auto merged = false;
+            for (auto& s : stats)
+            {
+                if (s.name == name)
+                {
+                    s.minMilliseconds = juce::jmin (s.minMilliseconds, min);
+                    s.maxMilliseconds = juce::jmax (s.maxMilliseconds, max);
+                    s.totalMilliseconds += total;
+                    s.count += count;
+                    merged = true;
+                    break;
+                }
+            }
+
+            if (!merged)
+            {
+                Stats s;
+                s.name = name;
+                s.count = count;
+                s.totalMilliseconds = total;
+                s.minMilliseconds = min;
+                s.maxMilliseconds = max;
+                stats.add (s);
+            }
+        }
+    }
+
+    return stats;
+}
+
+juce::String Profiler::exportChromeTrace() const
+{
+    juce::MemoryOutputStream output;
+    output << "{\"traceEvents\":[";
+
+    auto first = true;
+
+    for (const auto& data : mThreads)
+    {
+        const auto numWritten = data.numWritten.load (std::memory_order_acquire);
+        const auto numAvailable = juce::jmin (numWritten, static_cast<juce::uint32> (numEvents));
+
+        for (auto i = numWritten - numAvailable; i != numWritten; ++i)
+        {
+            const auto& event = data.events[i % static_cast<juce::uint32> (numEvents)];
+            const auto name = event.name.load (std::memory_order_relaxed);
+
+            if (name == nullptr)
+                continue;
+
+            const auto start = ticksToMicroseconds (event.startTicks.load (std::memory_order_relaxed) - mOriginTicks);
+            const auto duration = ticksToMicroseconds (event.durationTicks.load (std::memory_order_relaxed));
+
+            output << (first ? "" : ",")
+                   << "{\"name\":\"" << escapeJson (name)
+                   << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << data.threadIndex
+                   << ",\"ts\":" << juce::String (start, 3)
+                   << ",\"dur\":" << juce::String (duration, 3) << "}";
+            first = false;
+        }
+
+        for (const auto& site : data.sites)
+        {
+            const auto name = site.name.load (std::memory_order_acquire);
+
+            if (name == nullptr || !site.isCounter.load (std::memory_order_relaxed))
+                continue;
+
+            output << (first ? "" : ",")
+                   << "{\"name\":\"" << escapeJson (name)
+                   << "\",\"ph\":\"C\",\"pid\":1,\"tid\":" << data.threadIndex
+                   << ",\"ts\":0,\"args\":{\"value\":"
+                   << juce::String (site.totalTicks.load (std::memory_order_relaxed)) << "}}";
+            first = false;
+        }
+    }
+
+    output << "]}";
+    return output.toString();
+}
+
+bool Profiler::exportChromeTrace (const juce::File& file) const
+{
+    return file.replaceWithText (exportChromeTrace());
+}
+
+void Profiler::reset()
+{
+    for (auto& data : mThreads)
+    {
+        for (auto& site : data.sites)
+        {
+            site.count.store (0, std::memory_order_relaxed);
+            site.totalTicks.store (0, std::memory_order_relaxed);
+            site.minTicks.store (0, std::memory_order_relaxed);
+            site.maxTicks.store (0, std::memory_order_relaxed);
+        }
+
+        for (auto& event : data.events)
+        {
+            event.name.store (nullptr, std::memory_order_relaxed);
+        }
+    }
+}
+
+//==============================================================================
+
+Profiler::ThreadData* Profiler::getThreadData()
+{
+    struct ThreadSlot
+    {
+        ~ThreadSlot()
+        {
+            if (data != nullptr)
+                data->inUse.store (false, std::memory_order_release);
+        }
+
+        ThreadData* data = nullptr;
+    };
+
+    static thread_local ThreadSlot slot;
+
+    if (slot.data == nullptr)
+    {
+        for (auto& data : mThreads)
+        {
+            auto expected = false;
+            if (data.inUse.compare_exchange_strong (expected, true, std::memory_order_acq_rel))
+            {
+                slot.data = &data;
+                break;
+            }
+        }
+    }
+
+    return slot.data;
+}
+
+Profiler::Site* Profiler::findSite (ThreadData& data, const char* name, bool isCounter)
+{
+    const auto hash = static_cast<size_t> (reinterpret_cast<juce::pointer_sized_uint> (name) >> 3);
+
+    for (int probe = 0; probe < numSites; ++probe)
+    {
+        auto& site = data.sites[(hash + static_cast<size_t> (probe)) % numSites];
+        const auto siteName = site.name.load (std::memory_order_relaxed);
+
+        if (siteName == name)
+            return &site;
+
+        if (siteName == nullptr)
+        {
+            site.isCounter.store (isCounter, std::memory_order_relaxed);
+            site.name.store (name, std::memory_order_release);
+            return &site;
+        }
+    }
+
+    return nullptr;
+}
+
+//==============================================================================
+
+} // namespace helpers
+} // namespace grape
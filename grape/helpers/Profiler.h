@@ -0,0 +1,151 @@
+/*
+    GRAPE is Romain's Audio Plug-in Extension classes for the JUCE framework
+
+    Copyright (c) 2018 Romain Clement
+
+    MIT License    
+    
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+    
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+ */
+
+//==============================================================================
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <atomic>
+
+//==============================================================================
+
+#ifndef GRAPE_ENABLE_PROFILING
+ #define GRAPE_ENABLE_PROFILING 0
+#endif
+
+#if GRAPE_ENABLE_PROFILING
+ #define GRAPE_PROFILE_SCOPE(name) \
+    const grape::helpers::Profiler::ScopedTimer JUCE_JOIN_MACRO (grapeProfileScope_, __LINE__) (name)
+ #define GRAPE_PROFILE_COUNT(name, delta) \
+    grape::helpers::Profiler::getInstance().incrementCounter (name, delta)
+#else
+ #define GRAPE_PROFILE_SCOPE(name)
+ #define GRAPE_PROFILE_COUNT(name, delta)
+#endif
+
+//==============================================================================
+
+namespace grape {
+namespace helpers {
+
+//==============================================================================
+
+class Profiler
+{
+public:
+    struct Stats
+    {
+        juce::String name;
+        juce::int64 count = 0;
+        double totalMilliseconds = 0.0;
+        double minMilliseconds = 0.0;
+        double maxMilliseconds = 0.0;
+
+        inline double getAverageMilliseconds() const
+        {
+            return count > 0 ? totalMilliseconds / static_cast<double> (count) : 0.0;
+        }
+    };
+
+    class ScopedTimer
+    {
+    public:
+        ScopedTimer (const char* name);
+        ~ScopedTimer();
+
+    private:
+        const char*     mName;
+        juce::int64     mStartTicks;
+
+        JUCE_DECLARE_NON_COPYABLE (ScopedTimer)
+    };
+
+public:
+    static Profiler& getInstance();
+
+public:
+    void recordEvent (const char* name, juce::int64 startTicks, juce::int64 endTicks);
+    void incrementCounter (const char* name, juce::int64 delta = 1);
+
+    juce::Array<Stats> getStats() const;
+    juce::String exportChromeTrace() const;
+    bool exportChromeTrace (const juce::File&) const;
+    void reset();
+
+private:
+    static constexpr int numSites = 128;
+    static constexpr int numEvents = 4096;
+    static constexpr int numThreadSlots = 16;
+
+    struct Site
+    {
+        std::atomic<const char*>    name { nullptr };
+        std::atomic<bool>           isCounter { false };
+        std::atomic<juce::int64>    count { 0 };
+        std::atomic<juce::int64>    totalTicks { 0 };
+        std::atomic<juce::int64>    minTicks { 0 };
+        std::atomic<juce::int64>    maxTicks { 0 };
+    };
+
+    struct Event
+    {
+        std::atomic<const char*>    name { nullptr };
+        std::atomic<juce::int64>    startTicks { 0 };
+        std::atomic<juce::int64>    durationTicks { 0 };
+    };
+
+    // Slots are preallocated with the profiler and claimed by threads on
+    // their first event, then released when the thread exits, so recording
+    // never allocates or locks. Events from threads beyond numThreadSlots
+    // concurrently alive are dropped.
+    struct ThreadData
+    {
+        std::atomic<bool>           inUse { false };
+        int                         threadIndex = 0;
+        Site                        sites[numSites];
+        Event                       events[numEvents];
+        std::atomic<juce::uint32>   numWritten { 0 };
+    };
+
+private:
+    Profiler();
+    ~Profiler();
+
+    ThreadData* getThreadData();
+    static Site* findSite (ThreadData&, const char* name, bool isCounter);
+
+private:
+    ThreadData                  mThreads[numThreadSlots];
+    const juce::int64           mOriginTicks;
+
+    JUCE_DECLARE_NON_COPYABLE (Profiler)
+};
+
+//==============================================================================
+
+} // namespace helpers
+} // namespace grape
@@ -0,0 +1,190 @@
+/*
+    GRAPE is Romain's Audio Plug-in Extension classes for the JUCE framework
+
+    Copyright (c) 2018 Romain Clement
+
+    MIT License    
+    
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+    
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+ */
+
+//==============================================================================
+
+#include <grape/helpers/RealtimeGuard.h>
+#include <cstdlib>
+#include <new>
+
+//==============================================================================
+
+namespace grape {
+namespace helpers {
+
+//==============================================================================
+
+static thread_local int sAudioThreadDepth = 0;
+static thread_local bool sReporting = false;
+
+static std::atomic<int> sNumViolations (0);
+static juce::SpinLock sHandlerLock;
+
+static RealtimeGuard::Handler& getHandler()
+{
+    static RealtimeGuard::Handler handler;
+    return handler;
+}
+
+static const char* getViolationTypeName (RealtimeGuard::ViolationType type)
+{
+    switch (type)
+    {
+        case RealtimeGuard::nonRealtimeCall:    return "non-realtime call";
+        case RealtimeGuard::allocation:         return "allocation";
+        case RealtimeGuard::lockAcquisition:    return "lock acquisition";
+    }
+
+    return "violation";
+}
+
+//==============================================================================
+
+RealtimeGuard::ScopedAudioThread::ScopedAudioThread()
+{
+    ++sAudioThreadDepth;
+}
+
+RealtimeGuard::ScopedAudioThread::~ScopedAudioThread()
+{
+    --sAudioThreadDepth;
+}
+
+//==============================================================================
+
+bool RealtimeGuard::isAudioThread()
+{
+    return sAudioThreadDepth > 0;
+}
+
+void RealtimeGuard::checkNonRealtimeCall (const char* name)
+{
+    if (isAudioThread())
+        reportViolation (nonRealtimeCall, name);
+}
+
+void RealtimeGuard::checkAllocation (size_t numBytes)
+{
+    if (isAudioThread())
+        reportViolation (allocation, juce::String (static_cast<juce::int64> (numBytes)) + " bytes");
+}
+
+void RealtimeGuard::checkLockAcquisition (const char* name)
+{
+    if (isAudioThread())
+        reportViolation (lockAcquisition, name);
+}
+
+void RealtimeGuard::setViolationHandler (Handler handler)
+{
+    const juce::SpinLock::ScopedLockType lock (sHandlerLock);
+    getHandler() = handler;
+}
+
+int RealtimeGuard::getNumViolations()
+{
+    return sNumViolations.load();
+}
+
+void RealtimeGuard::resetViolations()
+{
+    sNumViolations = 0;
+}
+
+//==============================================================================
+
+void RealtimeGuard::reportViolation (ViolationType type, const juce::String& description)
+{
+    if (sReporting)
+        return;
+
+    const juce::ScopedValueSetter<bool> reporting (sReporting, true);
+    ++sNumViolations;
+
+    Violation violation { type, description, juce::SystemStats::getStackBacktrace() };
+
+    Handler handler;
+    {
+        const juce::SpinLock::ScopedLockType lock (sHandlerLock);
+        handler = getHandler();
+    }
+
+    if (handler != nullptr)
+    {
+        handler (violation);
+        return;
+    }
+
+    DBG ("GRAPE realtime violation (" << getViolationTypeName (type) << "): "
+         << violation.description << "\n" << violation.stackTrace);
+    jassertfalse;
+}
+
+//==============================================================================
+
+} // namespace helpers
+} // namespace grape
+
+//==============================================================================
+
+#if GRAPE_ENABLE_REALTIME_GUARD && GRAPE_REALTIME_GUARD_HOOK_ALLOCATIONS
+
+void* operator new (size_t numBytes)
+{
+    grape::helpers::RealtimeGuard::checkAllocation (numBytes);
+
+    if (auto ptr = std::malloc (numBytes > 0 ? numBytes : 1))
+        return ptr;
+
+    throw std::bad_alloc();
+}
+
+void* operator new[] (size_t numBytes)
+{
+    return operator new (numBytes);
+}
+
+void operator delete (void* ptr) noexcept
+{
+    std::free (ptr);
+}
+
+void operator delete[] (void* ptr) noexcept
+{
+    std::free (ptr);
+}
+
+void operator delete (void* ptr, size_t) noexcept
+{
+    std::free (ptr);
+}
+
+void operator delete[] (void* ptr, size_t) noexcept
+{
+    std::free (ptr);
+}
+
+#endif
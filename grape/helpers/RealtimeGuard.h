@@ -0,0 +1,120 @@
+/*
+    GRAPE is Romain's Audio Plug-in Extension classes for the JUCE framework
+
+    Copyright (c) 2018 Romain Clement
+
+    MIT License    
+    
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+    
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+ */
+
+//==============================================================================
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <atomic>
+
+//==============================================================================
+
+#ifndef GRAPE_ENABLE_REALTIME_GUARD
+ #if JUCE_DEBUG
+  #define GRAPE_ENABLE_REALTIME_GUARD 1
+ #else
+  #define GRAPE_ENABLE_REALTIME_GUARD 0
+ #endif
+#endif
+
+#ifndef GRAPE_REALTIME_GUARD_HOOK_ALLOCATIONS
+ #define GRAPE_REALTIME_GUARD_HOOK_ALLOCATIONS 0
+#endif
+
+#if GRAPE_ENABLE_REALTIME_GUARD
+ #define GRAPE_SCOPED_AUDIO_THREAD \
+    const grape::helpers::RealtimeGuard::ScopedAudioThread JUCE_JOIN_MACRO (grapeAudioThread_, __LINE__)
+ #define GRAPE_ASSERT_NON_REALTIME(name) \
+    grape::helpers::RealtimeGuard::checkNonRealtimeCall (name)
+ #define GRAPE_ASSERT_NO_LOCK(name) \
+    grape::helpers::RealtimeGuard::checkLockAcquisition (name)
+ #define GRAPE_SCOPED_LOCK(ScopedLockType, lockObject) \
+    GRAPE_ASSERT_NO_LOCK (#lockObject); \
+    const ScopedLockType JUCE_JOIN_MACRO (grapeScopedLock_, __LINE__) (lockObject)
+#else
+ #define GRAPE_SCOPED_AUDIO_THREAD
+ #define GRAPE_ASSERT_NON_REALTIME(name)
+ #define GRAPE_ASSERT_NO_LOCK(name)
+ #define GRAPE_SCOPED_LOCK(ScopedLockType, lockObject) \
+    const ScopedLockType JUCE_JOIN_MACRO (grapeScopedLock_, __LINE__) (lockObject)
+#endif
+
+//==============================================================================
+
+namespace grape {
+namespace helpers {
+
+//==============================================================================
+
+class RealtimeGuard
+{
+public:
+    enum ViolationType
+    {
+        nonRealtimeCall,
+        allocation,
+        lockAcquisition
+    };
+
+    struct Violation
+    {
+        ViolationType type;
+        juce::String description;
+        juce::String stackTrace;
+    };
+
+    using Handler = std::function<void (const Violation&)>;
+
+    class ScopedAudioThread
+    {
+    public:
+        ScopedAudioThread();
+        ~ScopedAudioThread();
+
+    private:
+        JUCE_DECLARE_NON_COPYABLE (ScopedAudioThread)
+    };
+
+public:
+    static bool isAudioThread();
+
+    static void checkNonRealtimeCall (const char* name);
+    static void checkAllocation (size_t numBytes);
+    static void checkLockAcquisition (const char* name);
+
+    static void setViolationHandler (Handler handler);
+    static int getNumViolations();
+    static void resetViolations();
+
+private:
+    static void reportViolation (ViolationType, const juce::String& description);
+};
+
+//==============================================================================
+
+} // namespace helpers
+} // namespace grape
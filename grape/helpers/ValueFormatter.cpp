@@ -0,0 +1,254 @@
+/*
+    GRAPE is Romain's Audio Plug-in Extension classes for the JUCE framework
+
+    Copyright (c) 2018 Romain Clement
+
+    MIT License    
+    
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+    
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+ */
+
+//==============================================================================
+
+#include <grape/helpers/ValueFormatter.h>
+#include <grape/helpers/RealtimeGuard.h>
+#include <cmath>
+#include <cstdio>
+
+//==============================================================================
+
+namespace grape {
+namespace helpers {
+
+//==============================================================================
+
+static const float minusInfinityDecibels = -100.0f;
+static const int maxDecimalPlaces = 6;
+
+static int appendText (const char* text, char* buffer, int position, int bufferSize) noexcept
+{
+    while (*text != 0 && position < bufferSize - 1)
+        buffer[position++] = *text++;
+
+    return position;
+}
+
+static int appendFixed (double value, int decimalPlaces, char* buffer, int position, int bufferSize) noexcept
+{
+    static const double powersOfTen[] = { 1.0, 1.0e1, 1.0e2, 1.0e3, 1.0e4, 1.0e5, 1.0e6 };
+    const auto scaled = std::round (std::abs (value) * powersOfTen[decimalPlaces]);
+
+    if (!std::isfinite (scaled) || scaled >= 1.0e15)
+    {
+        char fallback[32];
+        std::snprintf (fallback, sizeof (fallback), "%g", value);
+        return appendText (fallback, buffer, position, bufferSize);
+    }
+
+    auto remaining = static_cast<juce::uint64> (scaled);
+
+    // Digits are produced least significant first, with at least one
+    // integer digit before the decimal point.
+    char digits[24];
+    int numDigits = 0;
+    do
+    {
+        digits[numDigits++] = static_cast<char> ('0' + remaining % 10);
+        remaining /= 10;
+    }
+    while (remaining > 0 || numDigits <= decimalPlaces);
+
+    // Values rounding to zero are shown without a sign, never as "-0.00"
+    if (value < 0.0 && scaled > 0.0)
+        position = appendText ("-", buffer, position, bufferSize);
+
+    for (int i = numDigits - 1; i >= 0 && position < bufferSize - 1; --i)
+    {
+        if (i == decimalPlaces - 1)
+        {
+            buffer[position++] = '.';
+            if (position >= bufferSize - 1)
+                break;
+        }
+
+        buffer[position++] = digits[i];
+    }
+
+    return position;
+}
+
+//==============================================================================
+
+int formatValue (float value, const ValueFormat& format, char* buffer, int bufferSize) noexcept
+{
+    jassert (buffer != nullptr && bufferSize > 0);
+
+    const auto decimalPlaces = juce::jlimit (0, maxDecimalPlaces, format.decimalPlaces);
+    const char* suffix = format.suffix != nullptr ? format.suffix : "";
+    auto scaled = static_cast<double> (value);
+    auto isKilo = false;
+    int position = 0;
+
+    switch (format.scaling)
+    {
+        case ValueScaling::linear:
+            break;
+
+        case ValueScaling::gainToDecibels:
+            if (value <= juce::Decibels::decibelsToGain (minusInfinityDecibels))
+            {
+                position = appendText ("-inf", buffer, position, bufferSize);
+                position = appendText (suffix, buffer, position, bufferSize);
+                buffer[position] = 0;
+                return position;
+            }
+
+            scaled = 20.0 * std::log10 (scaled);
+            break;
+
+        case ValueScaling::frequency:
+            isKilo = std::abs (scaled) >= 1000.0;
+            if (isKilo)
+                scaled /= 1000.0;
+            break;
+
+        case ValueScaling::secondsToMilliseconds:
+            scaled *= 1000.0;
+            break;
+    }
+
+    position = appendFixed (scaled, decimalPlaces, buffer, position, bufferSize);
+
+    if (isKilo)
+    {
+        // " Hz" becomes " kHz": the prefix goes after any leading spaces
+        for (; *suffix == ' '; ++suffix)
+            position = appendText (" ", buffer, position, bufferSize);
+
+        position = appendText ("k", buffer, position, bufferSize);
+    }
+
+    position = appendText (suffix, buffer, position, bufferSize);
+    buffer[position] = 0;
+    return position;
+}
+
+FormattedValue formatValue (float value, const ValueFormat& format) noexcept
+{
+    FormattedValue result;
+    result.length = formatValue (value, format, result.text, FormattedValue::maxLength + 1);
+    return result;
+}
+
+bool parseValue (juce::CharPointer_UTF8 text, const ValueFormat& format, float& result) noexcept
+{
+    text = text.findEndOfWhitespace();
+
+    auto isNegative = false;
+    auto signPosition = text;
+    if (*signPosition == '-' || *signPosition == '+')
+    {
+        isNegative = (*signPosition == '-');
+        ++signPosition;
+    }
+
+    if (format.scaling == ValueScaling::gainToDecibels && isNegative
+        && juce::CharacterFunctions::toLowerCase (*signPosition) == 'i')
+    {
+        result = 0.0f;
+        return true;
+    }
+
+    auto end = text;
+    auto value = juce::CharacterFunctions::readDoubleValue (end);
+    if (end.getAddress() == text.getAddress())
+        return false;
+
+    // Only frequencies are written with a "k" prefix; elsewhere a trailing
+    // "k" is part of the unit or a typo and must not scale the value
+    end = end.findEndOfWhitespace();
+    if (format.scaling == ValueScaling::frequency && juce::CharacterFunctions::toLowerCase (*end) == 'k')
+        value *= 1000.0;
+
+    switch (format.scaling)
+    {
+        case ValueScaling::linear:                                       break;
+        case ValueScaling::gainToDecibels:          value = std::pow (10.0, value / 20.0); break;
+        case ValueScaling::frequency:                                    break;
+        case ValueScaling::secondsToMilliseconds:   value /= 1000.0;     break;
+    }
+
+    result = static_cast<float> (value);
+    return true;
+}
+
+float parseValue (const juce::String& text, const ValueFormat& format) noexcept
+{
+    auto result = 0.0f;
+    parseValue (text.getCharPointer(), format, result);
+    return result;
+}
+
+//==============================================================================
+
+ValueTextCache::ValueTextCache (const ValueFormat& format)
+    : mFormat (format)
+    , mLastValue (0.0f)
+    , mHasText (false)
+{
+}
+
+ValueTextCache::~ValueTextCache()
+{
+}
+
+//==============================================================================
+
+juce::String ValueTextCache::getText (float value)
+{
+    GRAPE_SCOPED_LOCK (juce::SpinLock::ScopedLockType, mLock);
+
+    if (!mHasText || value != mLastValue)
+    {
+        const auto formatted = formatValue (value, mFormat);
+        mLastText = formatted.toString();
+        mLastValue = value;
+        mHasText = true;
+    }
+
+    return mLastText;
+}
+
+//==============================================================================
+
+std::function<juce::String (float)> makeValueToTextFunction (const ValueFormat& format)
+{
+    auto cache = std::make_shared<ValueTextCache> (format);
+    return [cache] (float value) { return cache->getText (value); };
+}
+
+std::function<float (const juce::String&)> makeTextToValueFunction (const ValueFormat& format)
+{
+    return [format] (const juce::String& text) { return parseValue (text, format); };
+}
+
+//==============================================================================
+
+} // namespace helpers
+} // namespace grape
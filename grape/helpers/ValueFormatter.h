@@ -0,0 +1,119 @@
+/*
+    GRAPE is Romain's Audio Plug-in Extension classes for the JUCE framework
+
+    Copyright (c) 2018 Romain Clement
+
+    MIT License    
+    
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+    
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+ */
+
+//==============================================================================
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <functional>
+#include <memory>
+
+//==============================================================================
+
+namespace grape {
+namespace helpers {
+
+//==============================================================================
+
+enum class ValueScaling
+{
+    linear,
+    gainToDecibels,         // linear gain shown in dB, "-inf" below -100 dB
+    frequency,              // Hz, switching to kHz from 1000 Hz
+    secondsToMilliseconds
+};
+
+/** Describes how a parameter value is shown as text. The suffix (e.g. " dB")
+    is not copied and must point to a string with static storage.
+*/
+struct ValueFormat
+{
+    int decimalPlaces = 2;
+    ValueScaling scaling = ValueScaling::linear;
+    const char* suffix = "";
+};
+
+struct FormattedValue
+{
+    static constexpr int maxLength = 47;
+
+    char text[maxLength + 1] = {};
+    int length = 0;
+
+    inline juce::String toString() const { return juce::String::fromUTF8 (text, length); }
+};
+
+//==============================================================================
+
+/** Formats value into buffer without allocating and returns the number of
+    characters written, excluding the terminating null.
+*/
+int formatValue (float value, const ValueFormat&, char* buffer, int bufferSize) noexcept;
+FormattedValue formatValue (float value, const ValueFormat&) noexcept;
+
+/** Parses text written by formatValue (or typed by a user) back to a value,
+    undoing the scaling. The unit suffix is optional; for frequencies, a "k"
+    prefix multiplies by 1000. Returns false and leaves result untouched if no
+    number was found.
+*/
+bool parseValue (juce::CharPointer_UTF8 text, const ValueFormat&, float& result) noexcept;
+float parseValue (const juce::String& text, const ValueFormat&) noexcept;
+
+//==============================================================================
+
+/** Remembers the last value formatted for a parameter, so that repeated
+    value-to-text requests for an unchanged value only copy a reference-counted
+    string.
+*/
+class ValueTextCache
+{
+public:
+    explicit ValueTextCache (const ValueFormat&);
+    ~ValueTextCache();
+
+public:
+    juce::String getText (float value);
+    inline const ValueFormat& getFormat() const { return mFormat; }
+
+private:
+    const ValueFormat   mFormat;
+    juce::SpinLock      mLock;
+    float               mLastValue;
+    juce::String        mLastText;
+    bool                mHasText;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ValueTextCache)
+};
+
+/** Adapters for Parameter::valueToTextFunction / textToValueFunction. */
+std::function<juce::String (float)> makeValueToTextFunction (const ValueFormat&);
+std::function<float (const juce::String&)> makeTextToValueFunction (const ValueFormat&);
+
+//==============================================================================
+
+} // namespace helpers
+} // namespace grape
@@ -27,6 +27,8 @@
 //==============================================================================
 
 #include <grape/parameters/ParameterManager.h>
+#include <grape/helpers/Profiler.h>
+#include <grape/helpers/RealtimeGuard.h>
 
 //==============================================================================
 
@@ -41,6 +43,11 @@ ParameterManager::ParameterManager (juce::AudioProcessor& processor,
                                     const juce::String& identifier)
     : AudioProcessorValueTreeState (processor, undoManager)
     , mParametersInfo (parametersInfo)
+    , mChangedFlags (parametersInfo.size())
+    , mValueHashes (parametersInfo.size())
+    , mContentHash (0)
+    , mFirstParameterIndex (0)
+    , mChangeTracker (*this)
 {
     for (const auto& p : mParametersInfo)
     {
@@ -48,17 +55,34 @@ ParameterManager::ParameterManager (juce::AudioProcessor& processor,
     }
 
     state = juce::ValueTree (juce::Identifier (identifier));
+
+    if (mParameters.size() > 0)
+    {
+        mFirstParameterIndex = mParameters.getFirst()->getParameterIndex();
+    }
+
+    for (int i = 0; i < mParameters.size(); ++i)
+    {
+        mValueHashes[static_cast<size_t> (i)].store (0);
+        updateContentHash (i, mParameters.getUnchecked (i)->getValue());
+        mParameters.getUnchecked (i)->addListener (&mChangeTracker);
+    }
 }
 
 ParameterManager::~ParameterManager()
 {
-
+    for (auto* param : mParameters)
+    {
+        param->removeListener (&mChangeTracker);
+    }
 }
 
 //==============================================================================
 
 void ParameterManager::resetAll()
 {
+    GRAPE_ASSERT_NON_REALTIME ("ParameterManager::resetAll");
+
     for (const auto& p : mParametersInfo)
     {
         auto param = getParameter (p.id);
@@ -69,25 +93,414 @@ void ParameterManager::resetAll()
     }
 }
 
+int ParameterManager::indexOfParameter (const juce::String& parameterID) const
+{
+    return mParameterIndexes.contains (parameterID) ? mParameterIndexes[parameterID] : -1;
+}
+
+int ParameterManager::indexOfProcessorParameter (int processorParameterIndex) const
+{
+    const auto index = processorParameterIndex - mFirstParameterIndex;
+    return juce::isPositiveAndBelow (index, mParameters.size()) ? index : -1;
+}
+
+void ParameterManager::copyValues (float* destValues) const
+{
+    for (int i = 0; i < mParameters.size(); ++i)
+    {
+        destValues[i] = mParameters.getUnchecked (i)->getValue();
+    }
+}
+
+void ParameterManager::applyValues (const float* sourceValues, bool notifyHost)
+{
+    for (int i = 0; i < mParameters.size(); ++i)
+    {
+        auto param = mParameters.getUnchecked (i);
+        if (param->getValue() != sourceValues[i])
+        {
+            if (notifyHost)
+                param->setValueNotifyingHost (sourceValues[i]);
+            else
+                param->setValue (sourceValues[i]);
+        }
+    }
+}
+
+void ParameterManager::notifyChangedValues()
+{
+    GRAPE_ASSERT_NON_REALTIME ("ParameterManager::notifyChangedValues");
+
+    // The value hashes follow the last notified values, so they tell which
+    // parameters were changed by applyValues (..., false) since
+    juce::Array<int> changedIndexes;
+    for (int i = 0; i < mParameters.size(); ++i)
+    {
+        const auto& range = mParametersInfo[static_cast<size_t> (i)].valueRange;
+        const auto value = range.convertFrom0to1 (mParameters.getUnchecked (i)->getValue());
+        const auto hash = state::StateHash::hashParameter (mIdHashes[static_cast<size_t> (i)], value);
+
+        if (hash != mValueHashes[static_cast<size_t> (i)].load())
+            changedIndexes.add (i);
+    }
+
+    // One gesture around all of them, so hosts and the undo history see a
+    // single change
+    for (auto i : changedIndexes)
+        mParameters.getUnchecked (i)->beginChangeGesture();
+
+    for (auto i : changedIndexes)
+    {
+        auto param = mParameters.getUnchecked (i);
+        param->sendValueChangedMessageToListeners (param->getValue());
+    }
+
+    for (auto i : changedIndexes)
+        mParameters.getUnchecked (i)->endChangeGesture();
+}
+
+state::StateDiff ParameterManager::diffFrom (const juce::ValueTree& referenceState) const
+{
+    GRAPE_ASSERT_NON_REALTIME ("ParameterManager::diffFrom");
+
+    state::StateDiff diff;
+
+    for (int i = 0; i < referenceState.getNumChildren(); ++i)
+    {
+        const auto child = referenceState.getChild (i);
+        const auto id = child.getProperty ("id").toString();
+        const auto index = indexOfParameter (id);
+
+        if (index < 0)
+            continue;
+
+        const auto& range = mParametersInfo[static_cast<size_t> (index)].valueRange;
+        const auto& referenceValue = child.getProperty ("value");
+        const juce::var liveValue (range.convertFrom0to1 (mParameters.getUnchecked (index)->getValue()));
+
+        if (!state::StateDiff::parameterValuesAreEqual (referenceValue, liveValue))
+        {
+            diff.add ({ id, true, referenceValue, liveValue });
+        }
+    }
+
+    return diff;
+}
+
+bool ParameterManager::matchesState (const juce::ValueTree& referenceState, float normalisedTolerance) const
+{
+    GRAPE_ASSERT_NON_REALTIME ("ParameterManager::matchesState");
+
+    for (int i = 0; i < referenceState.getNumChildren(); ++i)
+    {
+        const auto child = referenceState.getChild (i);
+        const auto index = indexOfParameter (child.getProperty ("id").toString());
+        const auto& referenceValue = child.getProperty ("value");
+
+        if (index < 0 || referenceValue.isVoid())
+            continue;
+
+        // Compared in the normalised domain, where text and range round-trips
+        // leave errors far below the tolerance
+        const auto& range = mParametersInfo[static_cast<size_t> (index)].valueRange;
+        const auto referenceNormalised = range.convertTo0to1 (static_cast<float> (static_cast<double> (referenceValue)));
+        const auto liveNormalised = mParameters.getUnchecked (index)->getValue();
+
+        if (std::abs (referenceNormalised - liveNormalised) > normalisedTolerance)
+            return false;
+    }
+
+    return true;
+}
+
+void ParameterManager::applyDiff (const state::StateDiff& diff)
+{
+    for (const auto& change : diff)
+    {
+        const auto index = change.isParameter ? indexOfParameter (change.id) : -1;
+
+        if (index < 0 || change.newValue.isVoid())
+            continue;
+
+        const auto& range = mParametersInfo[static_cast<size_t> (index)].valueRange;
+        const auto value = static_cast<float> (static_cast<double> (change.newValue));
+        mParameters.getUnchecked (index)->setValueNotifyingHost (range.convertTo0to1 (value));
+    }
+}
+
 juce::XmlElement* ParameterManager::toXml()
 {
+    GRAPE_ASSERT_NON_REALTIME ("ParameterManager::toXml");
+    GRAPE_PROFILE_SCOPE ("ParameterManager::toXml");
+
     const auto stateParameters = copyState();
     return stateParameters.createXml();
 }
 
 void ParameterManager::fromXml (const juce::XmlElement& xmlState)
 {
+    GRAPE_ASSERT_NON_REALTIME ("ParameterManager::fromXml");
+    GRAPE_PROFILE_SCOPE ("ParameterManager::fromXml");
+
     if (xmlState.hasTagName (state.getType()))
     {
         replaceState (juce::ValueTree::fromXml (xmlState));
     }
 }
 
+void ParameterManager::writeToStream (juce::OutputStream& output) const
+{
+    output.writeCompressedInt (mParameters.size());
+
+    for (auto* param : mParameters)
+    {
+        output.writeString (param->paramID);
+        output.writeFloat (param->getValue());
+    }
+
+    // The rest of the tree follows the values, without the PARAM children
+    juce::ValueTree extraState (state.getType());
+    extraState.copyPropertiesFrom (state, nullptr);
+
+    for (const auto& child : state)
+    {
+        if (!child.hasType ("PARAM"))
+            extraState.appendChild (child.createCopy(), nullptr);
+    }
+
+    extraState.writeToStream (output);
+}
+
+bool ParameterManager::readFromStream (juce::InputStream& input)
+{
+    juce::Array<int> indexes;
+    juce::Array<float> values;
+
+    if (!readValuesFromStream (input, indexes, values))
+        return false;
+
+    // Streams written before the tree was appended end after the values
+    juce::ValueTree extraState;
+    if (!input.isExhausted())
+    {
+        extraState = juce::ValueTree::readFromStream (input);
+        if (!extraState.hasType (state.getType()))
+            return false;
+    }
+
+    applyParsedValues (indexes, values);
+
+    if (extraState.isValid())
+    {
+        juce::NamedValueSet properties;
+        for (int i = 0; i < extraState.getNumProperties(); ++i)
+        {
+            const auto name = extraState.getPropertyName (i);
+            properties.set (name, extraState.getProperty (name));
+        }
+
+        juce::Array<juce::ValueTree> children;
+        for (const auto& child : extraState)
+            children.add (child.createCopy());
+
+        replaceNonParameterState (properties, children);
+    }
+
+    return true;
+}
+
+void ParameterManager::writeXml (state::XmlStreamWriter& writer) const
+{
+    GRAPE_ASSERT_NON_REALTIME ("ParameterManager::writeXml");
+    GRAPE_PROFILE_SCOPE ("ParameterManager::writeXml");
+
+    const auto& tagName = state.getType().toString();
+    writer.startElement (tagName);
+
+    for (int i = 0; i < state.getNumProperties(); ++i)
+    {
+        const auto name = state.getPropertyName (i);
+        writer.writeVarAttribute (name.toString(), state.getProperty (name));
+    }
+
+    // Parameters are written from their live values, which the PARAM children
+    // of the tree only catch up with when the state is copied
+    for (int i = 0; i < mParameters.size(); ++i)
+    {
+        const auto param = mParameters.getUnchecked (i);
+        const auto& range = mParametersInfo[static_cast<size_t> (i)].valueRange;
+
+        writer.startElement ("PARAM");
+        writer.writeAttribute ("id", param->paramID);
+        writer.writeAttribute ("value", range.convertFrom0to1 (param->getValue()));
+        writer.endElement ("PARAM");
+    }
+
+    for (const auto& child : state)
+    {
+        if (!child.hasType ("PARAM"))
+            writer.writeValueTree (child);
+    }
+
+    writer.endElement (tagName);
+}
+
+bool ParameterManager::readXml (state::XmlStreamReader& reader)
+{
+    GRAPE_ASSERT_NON_REALTIME ("ParameterManager::readXml");
+    GRAPE_PROFILE_SCOPE ("ParameterManager::readXml");
+
+    if (!reader.hasTagName (state.getType().toString()))
+        return false;
+
+    // Nothing is applied until the whole element has been parsed
+    juce::NamedValueSet properties;
+    for (int i = 0; i < reader.getNumAttributes(); ++i)
+        properties.set (juce::Identifier (reader.getAttributeName (i)), reader.getAttributeValue (i));
+
+    juce::Array<juce::ValueTree> children;
+    juce::Array<int> indexes;
+    juce::Array<float> values;
+    int expectedIndex = 0;
+
+    for (;;)
+    {
+        const auto token = reader.next();
+
+        if (token == state::XmlStreamReader::endElement)
+            break;
+
+        if (token != state::XmlStreamReader::startElement)
+            return false;
+
+        if (!reader.hasTagName ("PARAM"))
+        {
+            const auto child = reader.readValueTree();
+            if (!child.isValid())
+                return false;
+
+            children.add (child);
+            continue;
+        }
+
+        const auto idAttribute = reader.findAttribute ("id");
+        const auto valueAttribute = reader.findAttribute ("value");
+
+        if (reader.hasTagName ("PARAM") && idAttribute >= 0 && valueAttribute >= 0)
+        {
+            const auto index = findParameterIndex (reader, idAttribute, expectedIndex);
+
+            if (index >= 0)
+            {
+                const auto& range = mParametersInfo[static_cast<size_t> (index)].valueRange;
+                const auto value = static_cast<float> (reader.getDoubleAttribute ("value"));
+                indexes.add (index);
+                values.add (range.convertTo0to1 (value));
+                expectedIndex = index + 1;
+            }
+        }
+
+        if (!reader.skipElement())
+            return false;
+    }
+
+    applyParsedValues (indexes, values);
+    replaceNonParameterState (properties, children);
+
+    return true;
+}
+
+void ParameterManager::checkpoint()
+{
+    for (auto& changed : mChangedFlags)
+    {
+        changed.store (false);
+    }
+}
+
+bool ParameterManager::hasChangesSinceCheckpoint() const
+{
+    for (const auto& changed : mChangedFlags)
+    {
+        if (changed.load())
+            return true;
+    }
+
+    return false;
+}
+
+void ParameterManager::writeChangesToStream (juce::OutputStream& output)
+{
+    mWrittenChanges.clearQuick();
+    for (int i = 0; i < mParameters.size(); ++i)
+    {
+        if (mChangedFlags[static_cast<size_t> (i)].exchange (false))
+        {
+            mWrittenChanges.add (i);
+        }
+    }
+
+    output.writeCompressedInt (mWrittenChanges.size());
+
+    for (auto i : mWrittenChanges)
+    {
+        const auto param = mParameters.getUnchecked (i);
+        output.writeString (param->paramID);
+        output.writeFloat (param->getValue());
+    }
+}
+
+void ParameterManager::restoreWrittenChanges()
+{
+    for (auto i : mWrittenChanges)
+    {
+        mChangedFlags[static_cast<size_t> (i)].store (true);
+    }
+
+    mWrittenChanges.clearQuick();
+}
+
+bool ParameterManager::readChangesFromStream (juce::InputStream& input)
+{
+    juce::Array<int> indexes;
+    juce::Array<float> values;
+
+    if (!readValuesFromStream (input, indexes, values))
+        return false;
+
+    applyParsedValues (indexes, values);
+    return true;
+}
+
+//==============================================================================
+
+ParameterManager::ChangeTracker::ChangeTracker (ParameterManager& parameterManager)
+    : mParameterManager (parameterManager)
+{
+
+}
+
+void ParameterManager::ChangeTracker::parameterValueChanged (int parameterIndex, float newValue)
+{
+    mParameterManager.markParameterChanged (parameterIndex);
+
+    const auto index = mParameterManager.indexOfProcessorParameter (parameterIndex);
+    if (index >= 0)
+    {
+        mParameterManager.updateContentHash (index, newValue);
+    }
+}
+
+void ParameterManager::ChangeTracker::parameterGestureChanged (int, bool)
+{
+
+}
+
 //==============================================================================
 
 void ParameterManager::addParameter (const parameters::Parameter& parameter)
 {
-    createAndAddParameter (
+    auto param = createAndAddParameter (
         parameter.id,
         parameter.name,
         parameter.label,
@@ -101,6 +514,104 @@ void ParameterManager::addParameter (const parameters::Parameter& parameter)
         parameter.category,
         parameter.isBoolean
     );
+
+    mParameterIndexes.set (parameter.id, mParameters.size());
+    mIdHashes.push_back (state::StateHash::hashIdentifier (parameter.id));
+    mParameters.add (param);
+}
+
+int ParameterManager::findParameterIndex (const state::XmlStreamReader& reader,
+                                          int idAttribute,
+                                          int expectedIndex) const
+{
+    if (juce::isPositiveAndBelow (expectedIndex, mParameters.size())
+        && reader.attributeValueMatches (idAttribute, mParameters.getUnchecked (expectedIndex)->paramID))
+    {
+        return expectedIndex;
+    }
+
+    for (int i = 0; i < mParameters.size(); ++i)
+    {
+        if (reader.attributeValueMatches (idAttribute, mParameters.getUnchecked (i)->paramID))
+            return i;
+    }
+
+    return -1;
+}
+
+bool ParameterManager::readValuesFromStream (juce::InputStream& input,
+                                             juce::Array<int>& indexes,
+                                             juce::Array<float>& values) const
+{
+    const auto numParameters = input.readCompressedInt();
+    if (numParameters < 0)
+        return false;
+
+    for (int i = 0; i < numParameters; ++i)
+    {
+        if (input.isExhausted())
+            return false;
+
+        const auto id = input.readString();
+        const auto value = input.readFloat();
+        const auto index = indexOfParameter (id);
+
+        if (index >= 0)
+        {
+            indexes.add (index);
+            values.add (juce::jlimit (0.0f, 1.0f, value));
+        }
+    }
+
+    return true;
+}
+
+void ParameterManager::applyParsedValues (const juce::Array<int>& indexes, const juce::Array<float>& values)
+{
+    for (int i = 0; i < indexes.size(); ++i)
+    {
+        mParameters.getUnchecked (indexes.getUnchecked (i))->setValueNotifyingHost (values.getUnchecked (i));
+    }
+}
+
+void ParameterManager::replaceNonParameterState (const juce::NamedValueSet& properties,
+                                                 const juce::Array<juce::ValueTree>& children)
+{
+    // Like replaceState(), everything in the tree except the parameters is
+    // replaced by what was read
+    while (state.getNumProperties() > 0)
+        state.removeProperty (state.getPropertyName (0), nullptr);
+
+    for (const auto& property : properties)
+        state.setProperty (property.name, property.value, nullptr);
+
+    for (int i = state.getNumChildren(); --i >= 0;)
+    {
+        if (!state.getChild (i).hasType ("PARAM"))
+            state.removeChild (i, nullptr);
+    }
+
+    for (const auto& child : children)
+        state.appendChild (child, nullptr);
+}
+
+void ParameterManager::markParameterChanged (int processorParameterIndex)
+{
+    const auto index = indexOfProcessorParameter (processorParameterIndex);
+    if (index >= 0)
+    {
+        mChangedFlags[static_cast<size_t> (index)].store (true);
+    }
+}
+
+void ParameterManager::updateContentHash (int index, float normalisedValue)
+{
+    const auto i = static_cast<size_t> (index);
+    const auto value = mParametersInfo[i].valueRange.convertFrom0to1 (normalisedValue);
+    const auto newHash = state::StateHash::hashParameter (mIdHashes[i], value);
+    const auto oldHash = mValueHashes[i].exchange (newHash);
+
+    mContentHash += newHash - oldHash;
 }
 
 //==============================================================================
@@ -30,6 +30,12 @@
 
 #include <JuceHeader.h>
 #include <grape/parameters/Parameter.h>
+#include <grape/state/StateDiff.h>
+#include <grape/state/StateHash.h>
+#include <grape/state/XmlStreamReader.h>
+#include <grape/state/XmlStreamWriter.h>
+#include <atomic>
+#include <vector>
 
 //==============================================================================
 
@@ -50,14 +56,72 @@ public:
 public:
     void resetAll();
 
+    inline int getNumParameters() const { return mParameters.size(); }
+    inline juce::AudioProcessorParameterWithID* getParameterByIndex (int index) const { return mParameters[index]; }
+    inline const Parameter& getParameterInfo (int index) const { return mParametersInfo[static_cast<size_t> (index)]; }
+
+    int indexOfParameter (const juce::String& parameterID) const;
+    int indexOfProcessorParameter (int processorParameterIndex) const;
+
+    void copyValues (float* destValues) const;
+    void applyValues (const float* sourceValues, bool notifyHost = true);
+    void notifyChangedValues();
+
+    state::StateDiff diffFrom (const juce::ValueTree& referenceState) const;
+    bool matchesState (const juce::ValueTree& referenceState, float normalisedTolerance = 1.0e-4f) const;
+    void applyDiff (const state::StateDiff&);
+
     juce::XmlElement* toXml();
     void fromXml (const juce::XmlElement&);
 
+    void writeToStream (juce::OutputStream&) const;
+    bool readFromStream (juce::InputStream&);
+
+    void writeXml (state::XmlStreamWriter&) const;
+    bool readXml (state::XmlStreamReader&);
+
+    void checkpoint();
+    bool hasChangesSinceCheckpoint() const;
+    void writeChangesToStream (juce::OutputStream&);
+    void restoreWrittenChanges();
+    bool readChangesFromStream (juce::InputStream&);
+
+    inline juce::uint64 getContentHash() const { return mContentHash.load(); }
+
+private:
+    class ChangeTracker : public juce::AudioProcessorParameter::Listener
+    {
+    public:
+        ChangeTracker (ParameterManager&);
+
+    private: // juce::AudioProcessorParameter::Listener
+        void parameterValueChanged (int, float) override;
+        void parameterGestureChanged (int, bool) override;
+
+    private:
+        ParameterManager& mParameterManager;
+    };
+
 private:
     void addParameter (const parameters::Parameter&);
+    int findParameterIndex (const state::XmlStreamReader&, int idAttribute, int expectedIndex) const;
+    bool readValuesFromStream (juce::InputStream&, juce::Array<int>& indexes, juce::Array<float>& values) const;
+    void applyParsedValues (const juce::Array<int>& indexes, const juce::Array<float>& values);
+    void replaceNonParameterState (const juce::NamedValueSet& properties, const juce::Array<juce::ValueTree>& children);
+    void markParameterChanged (int processorParameterIndex);
+    void updateContentHash (int index, float normalisedValue);
 
 private:
-    const std::vector<grape::parameters::Parameter> mParametersInfo;
+    const std::vector<grape::parameters::Parameter>         mParametersInfo;
+    juce::Array<juce::AudioProcessorParameterWithID*>       mParameters;
+    juce::HashMap<juce::String, int>                        mParameterIndexes;
+    std::vector<std::atomic<bool>>                          mChangedFlags;
+    juce::Array<int>                                        mWrittenChanges;
+    std::vector<juce::uint64>                               mIdHashes;
+    std::vector<std::atomic<juce::uint64>>                  mValueHashes;
+    std::atomic<juce::uint64>                               mContentHash;
+    int                                                     mFirstParameterIndex;
+    ChangeTracker                                           mChangeTracker;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ParameterManager)
 };
@@ -0,0 +1,108 @@
+/*
+    GRAPE is Romain's Audio Plug-in Extension classes for the JUCE framework
+
+    Copyright (c) 2018 Romain Clement
+
+    MIT License    
+    
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+    
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+ */
+
+//==============================================================================
+
+#include <grape/presets/EmbeddedPresets.h>
+#include <grape/presets/PresetCatalogue.h>
+#include <grape/helpers/Profiler.h>
+#include <algorithm>
+#include <cstring>
+
+//==============================================================================
+
+namespace grape {
+namespace presets {
+
+//==============================================================================
+
+const EmbeddedPresetTable& EmbeddedPresets::getTable() noexcept
+{
+   #if GRAPE_EMBEDDED_PRESETS
+    return embedded::table;
+   #else
+    static const EmbeddedPresetTable emptyTable { nullptr, 0, nullptr };
+    return emptyTable;
+   #endif
+}
+
+int EmbeddedPresets::indexOf (const juce::File& file)
+{
+    if (isEmpty())
+        return -1;
+
+    const auto location = PresetCatalogue::getFactoryPresetsLocation();
+    if (!file.isAChildOf (location))
+        return -1;
+
+    const auto relativePath = file.getRelativePathFrom (location).replaceCharacter ('\\', '/');
+    return indexOf (relativePath.toRawUTF8());
+}
+
+int EmbeddedPresets::indexOf (const char* relativePath) noexcept
+{
+    const auto& table = getTable();
+    const auto begin = table.presets;
+    const auto end = table.presets + table.numPresets;
+
+    const auto it = std::lower_bound (
+        begin, end, relativePath,
+        [] (const EmbeddedPreset& preset, const char* path)
+        {
+            return std::strcmp (preset.path, path) < 0;
+        }
+    );
+
+    if (it != end && std::strcmp (it->path, relativePath) == 0)
+        return static_cast<int> (it - begin);
+
+    return -1;
+}
+
+bool EmbeddedPresets::loadPresetData (int index, juce::MemoryBlock& data)
+{
+    GRAPE_PROFILE_SCOPE ("EmbeddedPresets::loadPresetData");
+
+    const auto& table = getTable();
+    if (!juce::isPositiveAndBelow (index, table.numPresets))
+        return false;
+
+    const auto& preset = table.presets[index];
+    juce::MemoryInputStream compressed (table.data + preset.offset, preset.compressedSize, false);
+    juce::GZIPDecompressorInputStream input (
+        &compressed, false,
+        juce::GZIPDecompressorInputStream::zlibFormat,
+        static_cast<juce::int64> (preset.size)
+    );
+
+    data.setSize (preset.size);
+    return input.read (data.getData(), static_cast<int> (preset.size)) == static_cast<int> (preset.size);
+}
+
+//==============================================================================
+
+} // namespace presets
+} // namespace grape
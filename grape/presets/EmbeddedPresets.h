@@ -0,0 +1,94 @@
+/*
+    GRAPE is Romain's Audio Plug-in Extension classes for the JUCE framework
+
+    Copyright (c) 2018 Romain Clement
+
+    MIT License    
+    
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+    
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+ */
+
+//==============================================================================
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+
+/** Set to 1 when the plug-in links a presets table generated by
+    tools/PresetPacker. The factory presets are then served from memory and
+    the factory presets location is never scanned.
+*/
+#ifndef GRAPE_EMBEDDED_PRESETS
+ #define GRAPE_EMBEDDED_PRESETS 0
+#endif
+
+//==============================================================================
+
+namespace grape {
+namespace presets {
+
+//==============================================================================
+
+struct EmbeddedPreset
+{
+    const char*     path;               // relative to the factory location, '/' separated
+    const char*     bank;
+    juce::uint32    offset;             // into EmbeddedPresetTable::data
+    juce::uint32    compressedSize;     // zlib
+    juce::uint32    size;
+};
+
+struct EmbeddedPresetTable
+{
+    const EmbeddedPreset*   presets;    // sorted by path, byte-wise
+    int                     numPresets;
+    const unsigned char*    data;
+};
+
+#if GRAPE_EMBEDDED_PRESETS
+namespace embedded {
+extern const EmbeddedPresetTable table;
+} // namespace embedded
+#endif
+
+//==============================================================================
+
+class EmbeddedPresets
+{
+public:
+    static const EmbeddedPresetTable& getTable() noexcept;
+    static inline bool isEmpty() noexcept { return getTable().numPresets == 0; }
+
+    /** Returns the index of the embedded preset standing in for file, or -1. */
+    static int indexOf (const juce::File& file);
+    static int indexOf (const char* relativePath) noexcept;
+
+    /** Decompresses an embedded preset. Only that preset is inflated. */
+    static bool loadPresetData (int index, juce::MemoryBlock& data);
+
+private:
+    JUCE_DECLARE_NON_COPYABLE (EmbeddedPresets)
+};
+
+//==============================================================================
+
+} // namespace presets
+} // namespace grape
@@ -27,6 +27,12 @@
 //==============================================================================
 
 #include <grape/presets/Preset.h>
+#include <grape/helpers/Helpers.h>
+#include <grape/presets/PresetTagIndex.h>
+#include <grape/presets/EmbeddedPresets.h>
+#include <grape/helpers/Profiler.h>
+#include <grape/helpers/RealtimeGuard.h>
+#include <grape/helpers/PluginIdentity.h>
 
 //==============================================================================
 
@@ -35,8 +41,45 @@ namespace presets {
 
 //==============================================================================
 
-static const juce::String sPresetManufacturer   = juce::String::toHexString (JucePlugin_ManufacturerCode);
-static const juce::String sPresetPlugin         = juce::String::toHexString (JucePlugin_PluginCode);
+static const juce::String sPresetManufacturer   = juce::String::toHexString (GRAPE_PLUGIN_MANUFACTURER_CODE);
+static const juce::String sPresetPlugin         = juce::String::toHexString (GRAPE_PLUGIN_CODE);
+
+//==============================================================================
+
+static bool readStateElement (state::XmlStreamReader& reader, juce::ValueTree& stateTree)
+{
+    for (;;)
+    {
+        const auto token = reader.next();
+
+        if (token == state::XmlStreamReader::endElement)
+            return true;
+
+        if (token != state::XmlStreamReader::startElement)
+            return false;
+
+        if (reader.hasTagName ("state"))
+        {
+            const auto childToken = reader.next();
+
+            if (childToken == state::XmlStreamReader::startElement)
+            {
+                stateTree = reader.readValueTree();
+
+                if (!reader.skipElement())
+                    return false;
+            }
+            else if (childToken != state::XmlStreamReader::endElement)
+            {
+                return false;
+            }
+        }
+        else if (!reader.skipElement())
+        {
+            return false;
+        }
+    }
+}
 
 //==============================================================================
 
@@ -53,6 +96,7 @@ Preset::Preset (const juce::File& presetFile,
     , mVersion (presetVersion)
     , mModified (false)
     , mState ()
+    , mContentHash (0)
 {
 
 }
@@ -80,55 +124,80 @@ inline bool Preset::operator!= (const Preset& other) const
 
 bool Preset::loadFromFile()
 {
+    GRAPE_ASSERT_NON_REALTIME ("Preset::loadFromFile");
+    GRAPE_PROFILE_SCOPE ("Preset::loadFromFile");
+
     if (mFile != juce::File())
     {
-        juce::XmlDocument xmlDoc (mFile);
-        std::unique_ptr<juce::XmlElement> xmlPreset (xmlDoc.getDocumentElement());
+        juce::MemoryBlock data;
+        const auto embeddedIndex = EmbeddedPresets::indexOf (mFile);
+
+        if (embeddedIndex >= 0 ? !EmbeddedPresets::loadPresetData (embeddedIndex, data)
+                               : !mFile.loadFileAsData (data))
+            return false;
+
+        return loadFromData (data.getData(), data.getSize());
+    }
+    return false;
+}
+
+bool Preset::loadFromData (const void* data, size_t sizeInBytes)
+{
+    state::XmlStreamReader reader (data, sizeInBytes);
+
+    if (reader.next() == state::XmlStreamReader::startElement && reader.hasTagName ("preset"))
+    {
+        const auto attManufacturer  = reader.getStringAttribute ("manufacturer");
+        const auto attPlugin        = reader.getStringAttribute ("plugin");
+        const auto attVersion       = reader.getIntAttribute ("version");
+
+        if (attManufacturer != sPresetManufacturer
+            || attPlugin != sPresetPlugin
+            || attVersion <= 0)
+            return false;
+
+        const auto attAuthor        = reader.getStringAttribute ("author");
+        const auto attComments      = reader.getStringAttribute ("comments");
+        const auto attTags          = reader.getStringAttribute ("tags");
 
-        if (xmlPreset.get() != nullptr && xmlPreset->hasTagName ("preset"))
+        juce::ValueTree childInternalState;
+
+        if (readStateElement (reader, childInternalState)
+            && childInternalState.isValid())
         {
-            const auto attManufacturer  = xmlPreset->getStringAttribute ("manufacturer");
-            const auto attPlugin        = xmlPreset->getStringAttribute ("plugin");
-            const auto attVersion       = xmlPreset->getIntAttribute ("version");
-            const auto attAuthor        = xmlPreset->getStringAttribute ("author");
-            const auto attComments      = xmlPreset->getStringAttribute ("comments");
-            const auto childState       = xmlPreset->getChildByName ("state");
-            const auto childInternalState = (
-                childState != nullptr
-                ? childState->getFirstChildElement()
-                : nullptr
-            );
-
-            if (attManufacturer == sPresetManufacturer
-                && attPlugin == sPresetPlugin
-                && attVersion > 0
-                && childInternalState != nullptr)
-            {
-                mVersion = attVersion;
-                mModified = false;
-                mAuthor = attAuthor;
-                mComments = attComments;
-                mState = juce::ValueTree::fromXml (*childInternalState);
+            mVersion = attVersion;
+            mModified = false;
+            mAuthor = attAuthor;
+            mComments = attComments;
+            setTags (juce::StringArray::fromTokens (attTags, ",", ""));
+            mState = childInternalState;
+            mContentHash = state::StateHash::hashState (mState);
 
-                return true;
-            }
+            return true;
         }
     }
+
     return false;
 }
 
 bool Preset::saveToFile()
 {
-    auto xmlState = new juce::XmlElement ("state");
-    xmlState->addChildElement (mState.createXml());
-
-    std::unique_ptr<juce::XmlElement> xmlPreset (new juce::XmlElement ("preset"));
-    xmlPreset->setAttribute ("manufacturer",    sPresetManufacturer);
-    xmlPreset->setAttribute ("plugin",          sPresetPlugin);
-    xmlPreset->setAttribute ("version",         mVersion);
-    xmlPreset->setAttribute ("author",          mAuthor);
-    xmlPreset->setAttribute ("comments",        mComments);
-    xmlPreset->addChildElement (xmlState);
+    GRAPE_ASSERT_NON_REALTIME ("Preset::saveToFile");
+    GRAPE_PROFILE_SCOPE ("Preset::saveToFile");
+
+    state::XmlStreamWriter writer;
+    writer.writeHeader();
+    writer.startElement ("preset");
+    writer.writeAttribute ("manufacturer",  sPresetManufacturer);
+    writer.writeAttribute ("plugin",        sPresetPlugin);
+    writer.writeAttribute ("version",       mVersion);
+    writer.writeAttribute ("author",        mAuthor);
+    writer.writeAttribute ("comments",      mComments);
+    writer.writeAttribute ("tags",          mTags.joinIntoString (","));
+    writer.startElement ("state");
+    writer.writeValueTree (mState);
+    writer.endElement ("state");
+    writer.endElement ("preset");
 
     const auto parentDir = mFile.getParentDirectory();
     if (!parentDir.exists())
@@ -136,7 +205,7 @@ bool Preset::saveToFile()
         parentDir.createDirectory();
     }
 
-    return xmlPreset->writeToFile (mFile, juce::String());
+    return helpers::replaceFileAtomically (mFile, writer.getData(), writer.getDataSize());
 }
 
 juce::XmlElement* Preset::toXml() const
@@ -150,6 +219,7 @@ juce::XmlElement* Preset::toXml() const
     xml->setAttribute ("bank",          mBank);
     xml->setAttribute ("author",        mAuthor);
     xml->setAttribute ("comments",      mComments);
+    xml->setAttribute ("tags",          mTags.joinIntoString (","));
     xml->setAttribute ("manufacturer",  sPresetManufacturer);
     xml->setAttribute ("plugin",        sPresetPlugin);
     xml->setAttribute ("version",       mVersion);
@@ -168,6 +238,7 @@ bool Preset::fromXml(const juce::XmlElement& xml)
         const auto attBank 	        = xml.getStringAttribute ("bank");
         const auto attAuthor        = xml.getStringAttribute ("author");
         const auto attComments      = xml.getStringAttribute ("comments");
+        const auto attTags          = xml.getStringAttribute ("tags");
         const auto attManufacturer  = xml.getStringAttribute ("manufacturer");
         const auto attPlugin        = xml.getStringAttribute ("plugin");
         const auto attVersion       = xml.getIntAttribute ("version");
@@ -191,9 +262,11 @@ bool Preset::fromXml(const juce::XmlElement& xml)
             mBank = attBank;
             mAuthor = attAuthor;
             mComments = attComments;
+            setTags (juce::StringArray::fromTokens (attTags, ",", ""));
             mVersion = attVersion;
             mModified = attModified;
             mState = juce::ValueTree::fromXml (*childInternalState);
+            mContentHash = state::StateHash::hashState (mState);
 
             return true;
         }
@@ -202,14 +275,149 @@ bool Preset::fromXml(const juce::XmlElement& xml)
     return false;
 }
 
+void Preset::writeToStream (juce::OutputStream& output) const
+{
+    output.writeString (mFile.getFullPathName());
+    output.writeString (mName);
+    output.writeString (mBank);
+    output.writeString (mAuthor);
+    output.writeString (mComments);
+    output.writeString (sPresetManufacturer);
+    output.writeString (sPresetPlugin);
+    output.writeCompressedInt (mVersion);
+    output.writeBool (mModified);
+    mState.writeToStream (output);
+    output.writeString (mTags.joinIntoString (","));
+}
+
+bool Preset::readFromStream (juce::InputStream& input, int formatVersion)
+{
+    const auto file             = input.readString();
+    const auto name             = input.readString();
+    const auto bank             = input.readString();
+    const auto author           = input.readString();
+    const auto comments         = input.readString();
+    const auto manufacturer     = input.readString();
+    const auto plugin           = input.readString();
+    const auto version          = input.readCompressedInt();
+    const auto modified         = input.readBool();
+    const auto stateTree        = juce::ValueTree::readFromStream (input);
+    const auto tags             = formatVersion >= 2 ? input.readString() : juce::String();
+
+    if (file != juce::String()
+        && name != juce::String()
+        && manufacturer == sPresetManufacturer
+        && plugin == sPresetPlugin
+        && version > 0
+        && stateTree.isValid())
+    {
+        mFile = juce::File (file);
+        mName = name;
+        mBank = bank;
+        mAuthor = author;
+        mComments = comments;
+        setTags (juce::StringArray::fromTokens (tags, ",", ""));
+        mVersion = version;
+        mModified = modified;
+        mState = stateTree;
+        mContentHash = state::StateHash::hashState (mState);
+
+        return true;
+    }
+
+    return false;
+}
+
+void Preset::writeXml (state::XmlStreamWriter& writer) const
+{
+    writer.startElement ("preset");
+    writer.writeAttribute ("file",          mFile.getFullPathName());
+    writer.writeAttribute ("name",          mName);
+    writer.writeAttribute ("bank",          mBank);
+    writer.writeAttribute ("author",        mAuthor);
+    writer.writeAttribute ("comments",      mComments);
+    writer.writeAttribute ("tags",          mTags.joinIntoString (","));
+    writer.writeAttribute ("manufacturer",  sPresetManufacturer);
+    writer.writeAttribute ("plugin",        sPresetPlugin);
+    writer.writeAttribute ("version",       mVersion);
+    writer.writeAttribute ("modified",      mModified ? 1 : 0);
+    writer.startElement ("state");
+    writer.writeValueTree (mState);
+    writer.endElement ("state");
+    writer.endElement ("preset");
+}
+
+bool Preset::readXml (state::XmlStreamReader& reader)
+{
+    if (!reader.hasTagName ("preset"))
+        return false;
+
+    const auto attFile          = reader.getStringAttribute ("file");
+    const auto attName          = reader.getStringAttribute ("name");
+    const auto attBank          = reader.getStringAttribute ("bank");
+    const auto attAuthor        = reader.getStringAttribute ("author");
+    const auto attComments      = reader.getStringAttribute ("comments");
+    const auto attTags          = reader.getStringAttribute ("tags");
+    const auto attManufacturer  = reader.getStringAttribute ("manufacturer");
+    const auto attPlugin        = reader.getStringAttribute ("plugin");
+    const auto attVersion       = reader.getIntAttribute ("version");
+    const auto attModified      = reader.getBoolAttribute ("modified");
+
+    juce::ValueTree childInternalState;
+
+    if (readStateElement (reader, childInternalState)
+        && attFile != juce::String()
+        && attName != juce::String()
+        && attManufacturer == sPresetManufacturer
+        && attPlugin == sPresetPlugin
+        && attVersion > 0
+        && childInternalState.isValid())
+    {
+        mFile = juce::File (attFile);
+        mName = attName;
+        mBank = attBank;
+        mAuthor = attAuthor;
+        mComments = attComments;
+        setTags (juce::StringArray::fromTokens (attTags, ",", ""));
+        mVersion = attVersion;
+        mModified = attModified;
+        mState = childInternalState;
+        mContentHash = state::StateHash::hashState (mState);
+
+        return true;
+    }
+
+    return false;
+}
+
+void Preset::setTags (const juce::StringArray& tags)
+{
+    mTags.clear();
+
+    for (const auto& tag : tags)
+    {
+        const auto normalised = PresetTagIndex::normaliseTag (tag);
+        if (normalised.isNotEmpty())
+            mTags.addIfNotAlreadyThere (normalised);
+    }
+}
+
+bool Preset::hasTag (const juce::String& tag) const
+{
+    return mTags.contains (PresetTagIndex::normaliseTag (tag));
+}
+
 juce::ValueTree Preset::copyState()
 {
+    GRAPE_PROFILE_SCOPE ("Preset::copyState");
+
     return mState.createCopy();
 }
 
 void Preset::replaceState (const juce::ValueTree& newState)
 {
     mState = newState;
+    mContentHash = state::StateHash::hashState (mState);
 }
 
 bool Preset::checkState (const juce::ValueTree& newState)
@@ -217,6 +425,16 @@ bool Preset::checkState (const juce::ValueTree& newState)
     return mState.isEquivalentTo (newState);
 }
 
+state::StateDiff Preset::diff (const juce::ValueTree& otherState) const
+{
+    return state::StateDiff (mState, otherState);
+}
+
+state::StateDiff Preset::diff (const Preset& other) const
+{
+    return diff (other.mState);
+}
+
 //==============================================================================
 
 } // namespace presets
@@ -29,6 +29,10 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include <grape/state/StateDiff.h>
+#include <grape/state/StateHash.h>
+#include <grape/state/XmlStreamReader.h>
+#include <grape/state/XmlStreamWriter.h>
 
 //==============================================================================
 
@@ -60,6 +64,15 @@ public:
     inline juce::String getComments() const { return mComments; }
     inline void setComments (const juce::String& comments) { mComments = comments; }
 
+    inline juce::File getFile() const { return mFile; }
+
+    inline int getVersion() const { return mVersion; }
+    inline void setVersion (int version) { mVersion = version; }
+
+    inline juce::StringArray getTags() const { return mTags; }
+    void setTags (const juce::StringArray& tags);
+    bool hasTag (const juce::String& tag) const;
+
     inline bool isModified() const { return mModified; }
     inline void setModified (bool modified) { mModified = modified; }
 
@@ -67,24 +80,39 @@ public:
     bool operator!= (const Preset& other) const;
 
     bool loadFromFile();
+    bool loadFromData (const void* data, size_t sizeInBytes);
     bool saveToFile();
 
     juce::XmlElement* toXml() const;
     bool fromXml(const juce::XmlElement& xml);
 
+    // formatVersion is that of the state::StateChunk holding the stream
+    void writeToStream (juce::OutputStream&) const;
+    bool readFromStream (juce::InputStream&, int formatVersion);
+
+    void writeXml (state::XmlStreamWriter&) const;
+    bool readXml (state::XmlStreamReader&);
+
     juce::ValueTree copyState();
     void replaceState (const juce::ValueTree&);
     bool checkState (const juce::ValueTree&);
 
+    inline const juce::ValueTree& getState() const { return mState; }
+    inline juce::uint64 getContentHash() const { return mContentHash; }
+    state::StateDiff diff (const juce::ValueTree&) const;
+    state::StateDiff diff (const Preset&) const;
+
 private:
     juce::File      mFile;
     juce::String    mName;
     juce::String    mBank;
     juce::String    mAuthor;
     juce::String    mComments;
+    juce::StringArray mTags;
     int         	mVersion;
     bool        	mModified;
     juce::ValueTree mState;
+    juce::uint64    mContentHash;
 };
 
 //==============================================================================
@@ -0,0 +1,272 @@
+/*
+    GRAPE is Romain's Audio Plug-in Extension classes for the JUCE framework
+
+    Copyright (c) 2018 Romain Clement
+
+    MIT License    
+    
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+    
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+ */
+
+//==============================================================================
+
+#include <grape/presets/PresetBitmap.h>
+#include <algorithm>
+
+//==============================================================================
+
+namespace grape {
+namespace presets {
+
+//==============================================================================
+
+constexpr int PresetBitmap::numWords;
+constexpr int PresetBitmap::bitsPerBlock;
+
+bool PresetBitmap::Block::isEmpty() const
+{
+    for (auto word : words)
+    {
+        if (word != 0)
+            return false;
+    }
+
+    return true;
+}
+
+//==============================================================================
+
+PresetBitmap::PresetBitmap()
+{
+
+}
+
+PresetBitmap::~PresetBitmap()
+{
+
+}
+
+//==============================================================================
+
+void PresetBitmap::add (int index)
+{
+    jassert (index >= 0);
+
+    const auto blockIndex = index / bitsPerBlock;
+    const auto bit = index % bitsPerBlock;
+
+    auto it = findBlock (blockIndex);
+    if (it == mBlocks.end() || it->index != blockIndex)
+    {
+        Block block;
+        block.index = blockIndex;
+        block.words.fill (0);
+        it = mBlocks.insert (it, block);
+    }
+
+    it->words[static_cast<size_t> (bit / 64)] |= (static_cast<juce::uint64> (1) << (bit % 64));
+}
+
+void PresetBitmap::remove (int index)
+{
+    const auto blockIndex = index / bitsPerBlock;
+    const auto bit = index % bitsPerBlock;
+
+    auto it = findBlock (blockIndex);
+    if (it == mBlocks.end() || it->index != blockIndex)
+        return;
+
+    it->words[static_cast<size_t> (bit / 64)] &= ~(static_cast<juce::uint64> (1) << (bit % 64));
+
+    if (it->isEmpty())
+        mBlocks.erase (it);
+}
+
+bool PresetBitmap::contains (int index) const
+{
+    if (index < 0)
+        return false;
+
+    const auto blockIndex = index / bitsPerBlock;
+    const auto bit = index % bitsPerBlock;
+
+    const auto it = findBlock (blockIndex);
+    if (it == mBlocks.end() || it->index != blockIndex)
+        return false;
+
+    return (it->words[static_cast<size_t> (bit / 64)] & (static_cast<juce::uint64> (1) << (bit % 64))) != 0;
+}
+
+void PresetBitmap::clear()
+{
+    mBlocks.clear();
+}
+
+int PresetBitmap::count() const
+{
+    auto total = 0;
+
+    for (const auto& block : mBlocks)
+    {
+        for (auto word : block.words)
+            total += juce::countNumberOfBits (word);
+    }
+
+    return total;
+}
+
+juce::Array<int> PresetBitmap::toArray() const
+{
+    juce::Array<int> indexes;
+    indexes.ensureStorageAllocated (count());
+
+    for (const auto& block : mBlocks)
+    {
+        for (int w = 0; w < numWords; ++w)
+        {
+            auto word = block.words[static_cast<size_t> (w)];
+            for (int bit = 0; word != 0; ++bit, word >>= 1)
+            {
+                if ((word & 1) != 0)
+                    indexes.add (block.index * bitsPerBlock + w * 64 + bit);
+            }
+        }
+    }
+
+    return indexes;
+}
+
+PresetBitmap PresetBitmap::operator& (const PresetBitmap& other) const
+{
+    PresetBitmap result;
+    auto a = mBlocks.begin();
+    auto b = other.mBlocks.begin();
+
+    while (a != mBlocks.end() && b != other.mBlocks.end())
+    {
+        if (a->index < b->index)
+        {
+            ++a;
+        }
+        else if (b->index < a->index)
+        {
+            ++b;
+        }
+        else
+        {
+            Block block;
+            block.index = a->index;
+            for (size_t w = 0; w < numWords; ++w)
+                block.words[w] = a->words[w] & b->words[w];
+
+            if (!block.isEmpty())
+                result.mBlocks.push_back (block);
+
+            ++a;
+            ++b;
+        }
+    }
+
+    return result;
+}
+
+PresetBitmap PresetBitmap::operator| (const PresetBitmap& other) const
+{
+    PresetBitmap result;
+    result.mBlocks.reserve (mBlocks.size() + other.mBlocks.size());
+
+    auto a = mBlocks.begin();
+    auto b = other.mBlocks.begin();
+
+    while (a != mBlocks.end() || b != other.mBlocks.end())
+    {
+        if (b == other.mBlocks.end() || (a != mBlocks.end() && a->index < b->index))
+        {
+            result.mBlocks.push_back (*a++);
+        }
+        else if (a == mBlocks.end() || b->index < a->index)
+        {
+            result.mBlocks.push_back (*b++);
+        }
+        else
+        {
+            Block block;
+            block.index = a->index;
+            for (size_t w = 0; w < numWords; ++w)
+                block.words[w] = a->words[w] | b->words[w];
+
+            result.mBlocks.push_back (block);
+            ++a;
+            ++b;
+        }
+    }
+
+    return result;
+}
+
+PresetBitmap PresetBitmap::andNot (const PresetBitmap& other) const
+{
+    PresetBitmap result;
+    auto b = other.mBlocks.begin();
+
+    for (const auto& block : mBlocks)
+    {
+        while (b != other.mBlocks.end() && b->index < block.index)
+            ++b;
+
+        if (b == other.mBlocks.end() || b->index != block.index)
+        {
+            result.mBlocks.push_back (block);
+            continue;
+        }
+
+        Block masked;
+        masked.index = block.index;
+        for (size_t w = 0; w < numWords; ++w)
+            masked.words[w] = block.words[w] & ~b->words[w];
+
+        if (!masked.isEmpty())
+            result.mBlocks.push_back (masked);
+    }
+
+    return result;
+}
+
+//==============================================================================
+
+std::vector<PresetBitmap::Block>::iterator PresetBitmap::findBlock (int blockIndex)
+{
+    return std::lower_bound (
+        mBlocks.begin(), mBlocks.end(), blockIndex,
+        [] (const Block& block, int value) { return block.index < value; }
+    );
+}
+
+std::vector<PresetBitmap::Block>::const_iterator PresetBitmap::findBlock (int blockIndex) const
+{
+    return std::lower_bound (
+        mBlocks.begin(), mBlocks.end(), blockIndex,
+        [] (const Block& block, int value) { return block.index < value; }
+    );
+}
+
+//==============================================================================
+
+} // namespace presets
+} // namespace grape
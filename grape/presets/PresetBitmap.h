@@ -0,0 +1,87 @@
+/*
+    GRAPE is Romain's Audio Plug-in Extension classes for the JUCE framework
+
+    Copyright (c) 2018 Romain Clement
+
+    MIT License    
+    
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+    
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+ */
+
+//==============================================================================
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <vector>
+
+//==============================================================================
+
+namespace grape {
+namespace presets {
+
+//==============================================================================
+
+class PresetBitmap
+{
+public:
+    PresetBitmap();
+    ~PresetBitmap();
+
+public:
+    void add (int index);
+    void remove (int index);
+    bool contains (int index) const;
+    void clear();
+
+    int count() const;
+    inline bool isEmpty() const { return mBlocks.empty(); }
+    juce::Array<int> toArray() const;
+
+    PresetBitmap operator& (const PresetBitmap&) const;
+    PresetBitmap operator| (const PresetBitmap&) const;
+    PresetBitmap andNot (const PresetBitmap&) const;
+
+private:
+    static constexpr int numWords = 16;
+    static constexpr int bitsPerBlock = numWords * 64;
+
+    struct Block
+    {
+        int index;
+        std::array<juce::uint64, numWords> words;
+
+        bool isEmpty() const;
+    };
+
+private:
+    std::vector<Block>::iterator findBlock (int blockIndex);
+    std::vector<Block>::const_iterator findBlock (int blockIndex) const;
+
+private:
+    std::vector<Block> mBlocks;
+
+    JUCE_LEAK_DETECTOR (PresetBitmap)
+};
+
+//==============================================================================
+
+} // namespace presets
+} // namespace grape
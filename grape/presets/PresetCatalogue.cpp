@@ -0,0 +1,874 @@
+/*
+    GRAPE is Romain's Audio Plug-in Extension classes for the JUCE framework
+
+    Copyright (c) 2018 Romain Clement
+
+    MIT License    
+    
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+    
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+ */
+
+//==============================================================================
+
+#include <grape/presets/PresetCatalogue.h>
+#include <grape/presets/EmbeddedPresets.h>
+#include <grape/helpers/Profiler.h>
+#include <grape/helpers/RealtimeGuard.h>
+#include <grape/helpers/PluginIdentity.h>
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+//==============================================================================
+
+namespace grape {
+namespace presets {
+
+//==============================================================================
+
+static bool isMacOS ()
+{
+    static const bool macOS = (
+        (juce::SystemStats::getOperatingSystemType()
+         & juce::SystemStats::OperatingSystemType::MacOSX) != 0
+    );
+
+    return macOS;
+}
+
+//==============================================================================
+
+PresetCatalogue::PresetCatalogue()
+    : mScanned (false)
+    , mIndexed (false)
+    , mIndexVersion (0)
+    , mGeneration (0)
+{
+
+}
+
+PresetCatalogue::~PresetCatalogue()
+{
+    cancelPendingUpdate();
+}
+
+//==============================================================================
+
+juce::File PresetCatalogue::getFactoryPresetsLocation()
+{
+    static const auto location = juce::File::getSpecialLocation (
+        juce::File::SpecialLocationType::commonApplicationDataDirectory
+    )
+    .getChildFile (isMacOS() ? "Application Support" : "")
+    .getChildFile (GRAPE_PLUGIN_MANUFACTURER)
+    .getChildFile (GRAPE_PLUGIN_NAME)
+    .getChildFile ("presets");
+
+    return location;
+}
+
+juce::File PresetCatalogue::getUserPresetsLocation() const
+{
+    static const auto location = juce::File::getSpecialLocation (
+        juce::File::SpecialLocationType::userApplicationDataDirectory
+    )
+    .getChildFile (isMacOS() ? "Application Support" : "")
+    .getChildFile (GRAPE_PLUGIN_MANUFACTURER)
+    .getChildFile (GRAPE_PLUGIN_NAME)
+    .getChildFile ("presets");
+
+    return location;
+}
+
+juce::Array<Preset> PresetCatalogue::getFactoryPresets()
+{
+    ensureScanned();
+
+    GRAPE_SCOPED_LOCK (juce::ScopedReadLock, mLock);
+    const auto location = getFactoryPresetsLocation();
+
+    juce::Array<Preset> presets;
+    presets.ensureStorageAllocated (static_cast<int> (mFactoryPresets.records.size()));
+
+    for (size_t i = 0; i < mFactoryPresets.records.size(); ++i)
+        presets.add (makePreset (location, mFactoryPresets, i));
+
+    return presets;
+}
+
+juce::Array<Preset> PresetCatalogue::getUserPresets()
+{
+    ensureScanned();
+
+    GRAPE_SCOPED_LOCK (juce::ScopedReadLock, mLock);
+    const auto location = getUserPresetsLocation();
+
+    juce::Array<Preset> presets;
+    presets.ensureStorageAllocated (static_cast<int> (mUserPresets.records.size()));
+
+    for (size_t i = 0; i < mUserPresets.records.size(); ++i)
+        presets.add (makePreset (location, mUserPresets, i));
+
+    return presets;
+}
+
+juce::Array<Preset> PresetCatalogue::getAllPresets()
+{
+    auto allPresets = getFactoryPresets();
+    allPresets.addArray (getUserPresets());
+    return allPresets;
+}
+
+int PresetCatalogue::getNumPresets()
+{
+    ensureScanned();
+
+    GRAPE_SCOPED_LOCK (juce::ScopedReadLock, mLock);
+    return getNumPresetsUnlocked();
+}
+
+Preset PresetCatalogue::getPreset (int index)
+{
+    ensureScanned();
+
+    GRAPE_SCOPED_LOCK (juce::ScopedReadLock, mLock);
+    return getPresetUnlocked (index);
+}
+
+int PresetCatalogue::indexOf (const Preset& preset)
+{
+    ensureScanned();
+
+    GRAPE_SCOPED_LOCK (juce::ScopedReadLock, mLock);
+    return indexOfFileUnlocked (preset.getFile());
+}
+
+juce::String PresetCatalogue::findPresetBank (const juce::File& presetFile,
+                                              const juce::File& presetBaseLocation) const
+{
+    auto bank = presetFile.getParentDirectory().getRelativePathFrom (presetBaseLocation);
+
+    if (bank == ".")
+        return juce::String();
+
+    return bank.upToFirstOccurrenceOf ("/", false, false);
+}
+
+juce::Array<Preset> PresetCatalogue::findPresetsWithHash (juce::uint64 contentHash, const PresetMigrator* migrator)
+{
+    ensureScanned();
+
+    GRAPE_SCOPED_LOCK (juce::ScopedLock, mIndexLock);
+    ensureIndexed (migrator);
+
+    GRAPE_SCOPED_LOCK (juce::ScopedReadLock, mLock);
+
+    juce::Array<Preset> presets;
+    const auto it = mHashIndex.find (contentHash);
+
+    if (it != mHashIndex.end())
+    {
+        for (auto slot : it->second)
+            presets.add (getPresetUnlocked (mSlotPositions[static_cast<size_t> (slot)]));
+    }
+
+    return presets;
+}
+
+juce::Array<juce::Array<Preset>> PresetCatalogue::findDuplicates (const PresetMigrator* migrator)
+{
+    ensureScanned();
+
+    GRAPE_SCOPED_LOCK (juce::ScopedLock, mIndexLock);
+    ensureIndexed (migrator);
+
+    GRAPE_SCOPED_LOCK (juce::ScopedReadLock, mLock);
+
+    juce::Array<juce::Array<Preset>> duplicates;
+
+    for (const auto& entry : mHashIndex)
+    {
+        if (entry.second.size() < 2)
+            continue;
+
+        juce::Array<Preset> group;
+        for (auto slot : entry.second)
+            group.add (getPresetUnlocked (mSlotPositions[static_cast<size_t> (slot)]));
+
+        duplicates.add (group);
+    }
+
+    return duplicates;
+}
+
+juce::StringArray PresetCatalogue::getAllTags()
+{
+    ensureScanned();
+
+    GRAPE_SCOPED_LOCK (juce::ScopedLock, mIndexLock);
+    ensureIndexed();
+
+    return mTagIndex.getAllTags();
+}
+
+int PresetCatalogue::countPresetsWithTag (const juce::String& tag)
+{
+    ensureScanned();
+
+    GRAPE_SCOPED_LOCK (juce::ScopedLock, mIndexLock);
+    ensureIndexed();
+
+    return mTagIndex.countPresetsWithTag (tag);
+}
+
+juce::Array<Preset> PresetCatalogue::findPresetsWithTags (const juce::StringArray& allOf,
+                                                          const juce::StringArray& anyOf,
+                                                          const juce::StringArray& noneOf)
+{
+    ensureScanned();
+
+    GRAPE_SCOPED_LOCK (juce::ScopedLock, mIndexLock);
+    ensureIndexed();
+
+    GRAPE_SCOPED_LOCK (juce::ScopedReadLock, mLock);
+
+    juce::Array<Preset> presets;
+    for (auto slot : mTagIndex.query (allOf, anyOf, noneOf).toArray())
+        presets.add (getPresetUnlocked (mSlotPositions[static_cast<size_t> (slot)]));
+
+    return presets;
+}
+
+int PresetCatalogue::countPresetsWithTags (const juce::StringArray& allOf,
+                                           const juce::StringArray& anyOf,
+                                           const juce::StringArray& noneOf)
+{
+    ensureScanned();
+
+    GRAPE_SCOPED_LOCK (juce::ScopedLock, mIndexLock);
+    ensureIndexed();
+
+    return mTagIndex.query (allOf, anyOf, noneOf).count();
+}
+
+void PresetCatalogue::refresh()
+{
+    GRAPE_ASSERT_NON_REALTIME ("PresetCatalogue::refresh");
+    GRAPE_PROFILE_SCOPE ("PresetCatalogue::refresh");
+
+    GRAPE_SCOPED_LOCK (juce::ScopedLock, mScanLock);
+
+    juce::StringArray banks;
+    juce::HashMap<juce::String, int> bankIndexes;
+
+    auto factoryPresets = EmbeddedPresets::isEmpty()
+        ? findPresets (getFactoryPresetsLocation(), banks, bankIndexes)
+        : findEmbeddedPresets (banks, bankIndexes);
+    // The folder is created here once, so the location itself never touches
+    // the file system; saving a preset recreates its folder if needed
+    const auto userLocation = getUserPresetsLocation();
+    if (!userLocation.isDirectory())
+        userLocation.createDirectory();
+
+    auto userPresets = findPresets (userLocation, banks, bankIndexes);
+
+    // Older versions stored absolute paths, which break when the presets
+    // folder moves; those are converted to keys and written back once
+    juce::StringArray favourites;
+    bool convertedFavourites = false;
+
+    for (const auto& line : juce::StringArray::fromLines (getFavouritesFile().loadFileAsString()))
+    {
+        auto key = line.trim();
+        if (juce::File::isAbsolutePath (key))
+        {
+            key = getFavouriteKey (juce::File (key));
+            convertedFavourites = true;
+        }
+
+        if (key.isNotEmpty())
+            favourites.addIfNotAlreadyThere (key);
+    }
+
+    if (convertedFavourites)
+        getFavouritesFile().replaceWithText (favourites.joinIntoString ("\n"));
+
+    {
+        GRAPE_SCOPED_LOCK (juce::ScopedLock, mIndexLock);
+        GRAPE_SCOPED_LOCK (juce::ScopedWriteLock, mLock);
+
+        std::swap (mFactoryPresets, factoryPresets);
+        std::swap (mUserPresets, userPresets);
+        mBanks.swapWith (banks);
+        mFavourites.swapWith (favourites);
+
+        mIndexed = false;
+        mHashIndex.clear();
+        mPresetHashes.clear();
+        mSlotPositions.clear();
+        mPositionSlots.clear();
+        mTagIndex.clear();
+        ++mGeneration;
+    }
+
+    mScanned = true;
+    triggerAsyncUpdate();
+}
+
+void PresetCatalogue::presetSaved (const Preset& preset)
+{
+    ensureScanned();
+
+    const auto& file = preset.getFile();
+    const auto location = getUserPresetsLocation();
+
+    {
+        GRAPE_SCOPED_LOCK (juce::ScopedLock, mIndexLock);
+        GRAPE_SCOPED_LOCK (juce::ScopedWriteLock, mLock);
+
+        const auto modified = file.getLastModificationTime().toMilliseconds();
+        auto position = indexOfFileUnlocked (file);
+
+        if (position < 0)
+        {
+            if (!file.isAChildOf (location))
+                return;
+
+            // A new preset: insert its record in order rather than rescanning
+            const auto bank = findPresetBank (file, location);
+            auto bankIndex = mBanks.indexOf (bank);
+            if (bankIndex < 0)
+            {
+                bankIndex = mBanks.size();
+                mBanks.add (bank);
+            }
+
+            const auto userPosition = insertRecord (mUserPresets, file.getRelativePathFrom (location), bankIndex, modified);
+            position = static_cast<int> (mFactoryPresets.records.size()) + userPosition;
+
+            if (mIndexed)
+                insertIndexSlot (position);
+        }
+        else
+        {
+            const auto numFactoryPresets = static_cast<int> (mFactoryPresets.records.size());
+            if (position < numFactoryPresets)
+                mFactoryPresets.records[static_cast<size_t> (position)].modified = modified;
+            else
+                mUserPresets.records[static_cast<size_t> (position - numFactoryPresets)].modified = modified;
+        }
+
+        // Re-saving changes the modification date, which may reorder too
+        ++mGeneration;
+
+        if (mIndexed)
+            indexPreset (mPositionSlots[static_cast<size_t> (position)], preset);
+    }
+
+    triggerAsyncUpdate();
+}
+
+juce::StringArray PresetCatalogue::getFavouriteFiles()
+{
+    ensureScanned();
+
+    juce::StringArray favourites;
+    {
+        GRAPE_SCOPED_LOCK (juce::ScopedReadLock, mLock);
+        favourites = mFavourites;
+    }
+
+    juce::StringArray favouriteFiles;
+    favouriteFiles.ensureStorageAllocated (favourites.size());
+
+    for (const auto& key : favourites)
+        favouriteFiles.add (getFavouriteFile (key).getFullPathName());
+
+    return favouriteFiles;
+}
+
+bool PresetCatalogue::isFavourite (const Preset& preset)
+{
+    ensureScanned();
+
+    const auto key = getFavouriteKey (preset.getFile());
+
+    GRAPE_SCOPED_LOCK (juce::ScopedReadLock, mLock);
+    return key.isNotEmpty() && mFavourites.contains (key);
+}
+
+void PresetCatalogue::setFavourite (const Preset& preset, bool favourite)
+{
+    ensureScanned();
+
+    const auto key = getFavouriteKey (preset.getFile());
+    if (key.isEmpty())
+        return;
+
+    juce::StringArray favourites;
+    {
+        GRAPE_SCOPED_LOCK (juce::ScopedWriteLock, mLock);
+
+        if (mFavourites.contains (key) == favourite)
+            return;
+
+        if (favourite)
+            mFavourites.add (key);
+        else
+            mFavourites.removeString (key);
+
+        ++mGeneration;
+        favourites = mFavourites;
+    }
+
+    getFavouritesFile().replaceWithText (favourites.joinIntoString ("\n"));
+    triggerAsyncUpdate();
+}
+
+std::shared_ptr<const PresetNavigator::Order> PresetCatalogue::getNavigationOrder (const juce::Array<PresetNavigator::SortKey>& sortKeys,
+                                                                                 bool favouritesFirst)
+{
+    GRAPE_ASSERT_NON_REALTIME ("PresetCatalogue::getNavigationOrder");
+
+    ensureScanned();
+
+    juce::String key (favouritesFirst ? "f" : "-");
+    for (auto sortKey : sortKeys)
+        key << static_cast<int> (sortKey);
+
+    GRAPE_SCOPED_LOCK (juce::ScopedLock, mOrderLock);
+
+    auto& cached = mNavigationOrders[key];
+    if (cached != nullptr && cached->generation == mGeneration.load())
+        return cached;
+
+    GRAPE_PROFILE_SCOPE ("PresetCatalogue::getNavigationOrder");
+
+    juce::Array<Preset> presets;
+    juce::StringArray favourites;
+    std::vector<juce::int64> modificationTimes;
+    int numFactoryPresets = 0;
+    juce::uint32 generation = 0;
+
+    {
+        GRAPE_SCOPED_LOCK (juce::ScopedReadLock, mLock);
+
+        generation = mGeneration.load();
+        numFactoryPresets = static_cast<int> (mFactoryPresets.records.size());
+        favourites = mFavourites;
+
+        const auto numPresets = getNumPresetsUnlocked();
+        presets.ensureStorageAllocated (numPresets);
+        modificationTimes.reserve (static_cast<size_t> (numPresets));
+
+        for (int i = 0; i < numPresets; ++i)
+            presets.add (getPresetUnlocked (i));
+
+        for (const auto* records : { &mFactoryPresets, &mUserPresets })
+            for (const auto& record : records->records)
+                modificationTimes.push_back (record.modified);
+    }
+
+    juce::StringArray favouriteFiles;
+    for (const auto& favourite : favourites)
+        favouriteFiles.add (getFavouriteFile (favourite).getFullPathName());
+
+    cached = PresetNavigator::createOrder (presets, numFactoryPresets, favouriteFiles, modificationTimes,
+                                           sortKeys, favouritesFirst, generation);
+    return cached;
+}
+
+void PresetCatalogue::addListener (Listener* listener)
+{
+    mListeners.add (listener);
+}
+
+void PresetCatalogue::removeListener (Listener* listener)
+{
+    mListeners.remove (listener);
+}
+
+//==============================================================================
+
+void PresetCatalogue::handleAsyncUpdate()
+{
+    GRAPE_PROFILE_SCOPE ("PresetCatalogue::handleAsyncUpdate");
+
+    mListeners.call (
+        [] (Listener& l) { l.presetCatalogueChanged(); }
+    );
+}
+
+//==============================================================================
+
+void PresetCatalogue::ensureScanned()
+{
+    GRAPE_ASSERT_NO_LOCK ("PresetCatalogue");
+
+    if (mScanned)
+        return;
+
+    const juce::ScopedLock scanLock (mScanLock);
+
+    if (!mScanned)
+    {
+        refresh();
+    }
+}
+
+void PresetCatalogue::ensureIndexed (const PresetMigrator* migrator)
+{
+    GRAPE_PROFILE_SCOPE ("PresetCatalogue::ensureIndexed");
+
+    // Called with mIndexLock held. Callers scan before taking it, so this
+    // does not touch mScanLock. Tag queries take the index as it is; hash
+    // queries need it migrated to the version of their migrator.
+    const auto version = migrator != nullptr ? migrator->getCurrentVersion() : 0;
+    const auto isUsable = [this, migrator, version]
+    {
+        return mIndexed && (migrator == nullptr || mIndexVersion == version);
+    };
+
+    while (!isUsable())
+    {
+        jassert (mScanned);
+        const auto generation = mGeneration.load();
+        const auto presets = getAllPresets();
+
+        std::vector<IndexEntry> entries (static_cast<size_t> (presets.size()));
+        for (int i = 0; i < presets.size(); ++i)
+        {
+            const auto path = presets.getReference (i).getFile().getFullPathName();
+            if (mIndexCache.contains (path))
+                entries[static_cast<size_t> (i)] = mIndexCache[path];
+        }
+
+        {
+            // Reading files must not block queries from other threads
+            const juce::ScopedUnlock indexUnlock (mIndexLock);
+
+            for (int i = 0; i < presets.size(); ++i)
+            {
+                auto& entry = entries[static_cast<size_t> (i)];
+                const auto& file = presets.getReference (i).getFile();
+
+                if (!entry.loaded
+                    || (migrator != nullptr && entry.migratedTo != version)
+                    || entry.modified != file.getLastModificationTime()
+                    || entry.size != file.getSize())
+                {
+                    entry = readIndexEntry (presets.getReference (i), migrator);
+                }
+            }
+        }
+
+        // A refresh or a save landed while the lock was released, or another
+        // thread built the index meanwhile
+        if (generation != mGeneration.load())
+            continue;
+
+        if (isUsable())
+            break;
+
+        mHashIndex.clear();
+        mHashIndex.reserve (entries.size());
+        mPresetHashes.assign (entries.size(), 0);
+        mSlotPositions.resize (entries.size());
+        mPositionSlots.resize (entries.size());
+        mTagIndex.clear();
+        mIndexCache.clear();
+
+        for (int i = 0; i < presets.size(); ++i)
+        {
+            const auto& entry = entries[static_cast<size_t> (i)];
+
+            mSlotPositions[static_cast<size_t> (i)] = i;
+            mPositionSlots[static_cast<size_t> (i)] = i;
+
+            if (entry.loaded)
+            {
+                indexSlot (i, entry.hash, entry.tags);
+                mIndexCache.set (presets.getReference (i).getFile().getFullPathName(), entry);
+            }
+        }
+
+        mIndexVersion = version;
+        mIndexed = true;
+    }
+}
+
+void PresetCatalogue::indexPreset (int slot, const Preset& preset)
+{
+    indexSlot (slot, preset.getContentHash(), preset.getTags());
+}
+
+void PresetCatalogue::indexSlot (int slot, juce::uint64 hash, const juce::StringArray& tags)
+{
+    const auto i = static_cast<size_t> (slot);
+    const auto previous = mHashIndex.find (mPresetHashes[i]);
+
+    if (previous != mHashIndex.end())
+    {
+        previous->second.removeFirstMatchingValue (slot);
+        if (previous->second.isEmpty())
+            mHashIndex.erase (previous);
+    }
+
+    mPresetHashes[i] = hash;
+    mHashIndex[mPresetHashes[i]].add (slot);
+    mTagIndex.setPresetTags (slot, tags);
+}
+
+PresetCatalogue::IndexEntry PresetCatalogue::readIndexEntry (const Preset& preset, const PresetMigrator* migrator)
+{
+    IndexEntry entry;
+    entry.modified = preset.getFile().getLastModificationTime();
+    entry.size = preset.getFile().getSize();
+    entry.migratedTo = migrator != nullptr ? migrator->getCurrentVersion() : 0;
+
+    auto loadedPreset = preset;
+    if (loadedPreset.loadFromFile())
+    {
+        // Migrated without the migrator's cache, which a whole library
+        // would only churn
+        if (migrator != nullptr && loadedPreset.getVersion() < migrator->getCurrentVersion())
+        {
+            auto state = loadedPreset.copyState();
+            auto stateVersion = loadedPreset.getVersion();
+
+            if (migrator->migrate (state, stateVersion))
+                loadedPreset.replaceState (state);
+        }
+
+        entry.hash = loadedPreset.getContentHash();
+        entry.tags = loadedPreset.getTags();
+        entry.loaded = true;
+    }
+
+    return entry;
+}
+
+void PresetCatalogue::insertIndexSlot (int position)
+{
+    const auto slot = static_cast<int> (mSlotPositions.size());
+
+    for (auto& slotPosition : mSlotPositions)
+    {
+        if (slotPosition >= position)
+            ++slotPosition;
+    }
+
+    mSlotPositions.push_back (position);
+    mPositionSlots.insert (mPositionSlots.begin() + position, slot);
+    mPresetHashes.push_back (0);
+}
+
+int PresetCatalogue::insertRecord (Records& records, const juce::String& relativePath, int bankIndex, juce::int64 modified)
+{
+    const auto utf8 = relativePath.toRawUTF8();
+    const auto it = std::lower_bound (
+        records.records.begin(), records.records.end(), utf8,
+        [&records] (const Record& record, const char* path)
+        {
+            return std::strcmp (records.paths.data() + record.pathOffset, path) < 0;
+        }
+    );
+
+    const auto pathOffset = static_cast<juce::uint32> (records.paths.size());
+    records.paths.insert (records.paths.end(), utf8, utf8 + std::strlen (utf8) + 1);
+
+    const auto inserted = records.records.insert (it, { pathOffset, static_cast<juce::uint32> (bankIndex), modified });
+    return static_cast<int> (inserted - records.records.begin());
+}
+
+juce::File PresetCatalogue::getFavouritesFile() const
+{
+    return getUserPresetsLocation().getChildFile ("favourites.txt");
+}
+
+juce::String PresetCatalogue::getFavouriteKey (const juce::File& file) const
+{
+    // The relative path starts with the bank folder, so keys stay valid
+    // wherever the presets folders live
+    const auto userLocation = getUserPresetsLocation();
+    if (file.isAChildOf (userLocation))
+        return "user:" + file.getRelativePathFrom (userLocation);
+
+    const auto factoryLocation = getFactoryPresetsLocation();
+    if (file.isAChildOf (factoryLocation))
+        return "factory:" + file.getRelativePathFrom (factoryLocation);
+
+    return juce::String();
+}
+
+juce::File PresetCatalogue::getFavouriteFile (const juce::String& key) const
+{
+    const auto relativePath = key.fromFirstOccurrenceOf (":", false, false);
+
+    if (key.startsWith ("user:"))
+        return getUserPresetsLocation().getChildFile (relativePath);
+
+    if (key.startsWith ("factory:"))
+        return getFactoryPresetsLocation().getChildFile (relativePath);
+
+    return juce::File();
+}
+
+PresetCatalogue::Records PresetCatalogue::findPresets (const juce::File& location,
+                                                       juce::StringArray& banks,
+                                                       juce::HashMap<juce::String, int>& bankIndexes) const
+{
+    GRAPE_PROFILE_SCOPE ("PresetCatalogue::findPresets");
+
+    // The iterator reports modification times from the same directory read,
+    // so dates cost nothing extra here and are never looked up when sorting
+    std::vector<std::pair<juce::String, juce::int64>> presetFiles;
+    juce::DirectoryIterator iterator (location, true, "*.xml", juce::File::findFiles);
+    juce::Time modified;
+
+    while (iterator.next (nullptr, nullptr, nullptr, &modified, nullptr, nullptr))
+        presetFiles.emplace_back (iterator.getFile().getRelativePathFrom (location), modified.toMilliseconds());
+
+    std::sort (presetFiles.begin(), presetFiles.end(), [] (const std::pair<juce::String, juce::int64>& a,
+                                                           const std::pair<juce::String, juce::int64>& b)
+    {
+        return std::strcmp (a.first.toRawUTF8(), b.first.toRawUTF8()) < 0;
+    });
+
+    Records records;
+    records.records.reserve (presetFiles.size());
+
+    for (const auto& presetFile : presetFiles)
+    {
+        const auto& relativePath = presetFile.first;
+        const auto bank = findPresetBank (location.getChildFile (relativePath), location);
+        if (!bankIndexes.contains (bank))
+        {
+            bankIndexes.set (bank, banks.size());
+            banks.add (bank);
+        }
+
+        const auto utf8 = relativePath.toRawUTF8();
+        const auto pathOffset = static_cast<juce::uint32> (records.paths.size());
+        records.paths.insert (records.paths.end(), utf8, utf8 + std::strlen (utf8) + 1);
+        records.records.push_back ({ pathOffset, static_cast<juce::uint32> (bankIndexes[bank]), presetFile.second });
+    }
+
+    records.records.shrink_to_fit();
+    records.paths.shrink_to_fit();
+
+    GRAPE_PROFILE_COUNT ("PresetCatalogue::presetsFound", static_cast<juce::int64> (records.records.size()));
+    return records;
+}
+
+PresetCatalogue::Records PresetCatalogue::findEmbeddedPresets (juce::StringArray& banks,
+                                                               juce::HashMap<juce::String, int>& bankIndexes) const
+{
+    const auto& table = EmbeddedPresets::getTable();
+
+    Records records;
+    records.records.reserve (static_cast<size_t> (table.numPresets));
+
+    for (int i = 0; i < table.numPresets; ++i)
+    {
+        const auto& preset = table.presets[i];
+
+        // The packer sorts entries so that lookups can binary search them
+        jassert (i == 0 || std::strcmp (table.presets[i - 1].path, preset.path) < 0);
+
+        const auto bank = juce::String::fromUTF8 (preset.bank);
+        if (!bankIndexes.contains (bank))
+        {
+            bankIndexes.set (bank, banks.size());
+            banks.add (bank);
+        }
+
+        const auto pathOffset = static_cast<juce::uint32> (records.paths.size());
+        records.paths.insert (records.paths.end(), preset.path, preset.path + std::strlen (preset.path) + 1);
+        records.records.push_back ({ pathOffset, static_cast<juce::uint32> (bankIndexes[bank]), 0 });
+    }
+
+    return records;
+}
+
+Preset PresetCatalogue::makePreset (const juce::File& location, const Records& records, size_t recordIndex) const
+{
+    const auto& record = records.records[recordIndex];
+    const auto relativePath = juce::String::fromUTF8 (records.paths.data() + record.pathOffset);
+
+    return Preset (location.getChildFile (relativePath), mBanks[static_cast<int> (record.bankIndex)]);
+}
+
+Preset PresetCatalogue::getPresetUnlocked (int index) const
+{
+    const auto numFactoryPresets = static_cast<int> (mFactoryPresets.records.size());
+
+    if (juce::isPositiveAndBelow (index, numFactoryPresets))
+        return makePreset (getFactoryPresetsLocation(), mFactoryPresets, static_cast<size_t> (index));
+
+    if (juce::isPositiveAndBelow (index - numFactoryPresets, static_cast<int> (mUserPresets.records.size())))
+        return makePreset (getUserPresetsLocation(), mUserPresets, static_cast<size_t> (index - numFactoryPresets));
+
+    return Preset();
+}
+
+int PresetCatalogue::getNumPresetsUnlocked() const
+{
+    return static_cast<int> (mFactoryPresets.records.size() + mUserPresets.records.size());
+}
+
+int PresetCatalogue::indexOfFileUnlocked (const juce::File& file) const
+{
+    const auto findInRecords = [&file] (const juce::File& location, const Records& records) -> int
+    {
+        if (!file.isAChildOf (location))
+            return -1;
+
+        const auto relativePath = file.getRelativePathFrom (location);
+        const auto utf8 = relativePath.toRawUTF8();
+
+        const auto it = std::lower_bound (
+            records.records.begin(), records.records.end(), utf8,
+            [&records] (const Record& record, const char* path)
+            {
+                return std::strcmp (records.paths.data() + record.pathOffset, path) < 0;
+            }
+        );
+
+        if (it != records.records.end() && std::strcmp (records.paths.data() + it->pathOffset, utf8) == 0)
+            return static_cast<int> (it - records.records.begin());
+
+        return -1;
+    };
+
+    const auto factoryIndex = findInRecords (getFactoryPresetsLocation(), mFactoryPresets);
+    if (factoryIndex >= 0)
+        return factoryIndex;
+
+    const auto userIndex = findInRecords (getUserPresetsLocation(), mUserPresets);
+    if (userIndex >= 0)
+        return static_cast<int> (mFactoryPresets.records.size()) + userIndex;
+
+    return -1;
+}
+
+//==============================================================================
+
+} // namespace presets
+} // namespace grape
@@ -0,0 +1,198 @@
+/*
+    GRAPE is Romain's Audio Plug-in Extension classes for the JUCE framework
+
+    Copyright (c) 2018 Romain Clement
+
+    MIT License    
+    
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+    
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+ */
+
+//==============================================================================
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <grape/presets/Preset.h>
+#include <grape/presets/PresetMigrator.h>
+#include <grape/presets/PresetNavigator.h>
+#include <grape/presets/PresetTagIndex.h>
+#include <atomic>
+#include <map>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+//==============================================================================
+
+namespace grape {
+namespace presets {
+
+//==============================================================================
+
+class PresetCatalogue : private juce::AsyncUpdater
+{
+public:
+    class Listener
+    {
+    public:
+        virtual ~Listener() {}
+
+    public:
+        virtual void presetCatalogueChanged() = 0;
+    };
+
+public:
+    PresetCatalogue();
+    ~PresetCatalogue();
+
+public:
+    static juce::File getFactoryPresetsLocation();
+    juce::File getUserPresetsLocation() const;
+
+    juce::Array<Preset> getFactoryPresets();
+    juce::Array<Preset> getUserPresets();
+    juce::Array<Preset> getAllPresets();
+
+    int getNumPresets();
+    Preset getPreset (int index);
+    int indexOf (const Preset&);
+
+    juce::String findPresetBank (const juce::File&, const juce::File&) const;
+
+    // Hashes are taken after migrating presets with the given migrator, so
+    // they compare with the state of presets loaded through it
+    juce::Array<Preset> findPresetsWithHash (juce::uint64 contentHash, const PresetMigrator* = nullptr);
+    juce::Array<juce::Array<Preset>> findDuplicates (const PresetMigrator* = nullptr);
+
+    juce::StringArray getAllTags();
+    int countPresetsWithTag (const juce::String& tag);
+    juce::Array<Preset> findPresetsWithTags (const juce::StringArray& allOf,
+                                             const juce::StringArray& anyOf = juce::StringArray(),
+                                             const juce::StringArray& noneOf = juce::StringArray());
+    int countPresetsWithTags (const juce::StringArray& allOf,
+                              const juce::StringArray& anyOf = juce::StringArray(),
+                              const juce::StringArray& noneOf = juce::StringArray());
+
+    void refresh();
+    void presetSaved (const Preset&);
+
+    juce::StringArray getFavouriteFiles();
+    bool isFavourite (const Preset&);
+    void setFavourite (const Preset&, bool favourite);
+
+    inline juce::uint32 getGeneration() const { return mGeneration.load(); }
+    std::shared_ptr<const PresetNavigator::Order> getNavigationOrder (const juce::Array<PresetNavigator::SortKey>& sortKeys,
+                                                                      bool favouritesFirst);
+
+    void addListener (Listener*);
+    void removeListener (Listener*);
+
+private: // juce::AsyncUpdater
+    void handleAsyncUpdate() override;
+
+private:
+    // Presets are stored as offsets into a packed, null-terminated UTF-8 blob
+    // of paths relative to their location, sorted for binary search. Banks are
+    // interned once in mBanks; names are derived from the file on demand.
+    // Modification times come from the scan so sorting never stats files.
+    struct Record
+    {
+        juce::uint32 pathOffset;
+        juce::uint32 bankIndex;
+        juce::int64  modified;      // milliseconds, 0 for embedded presets
+    };
+
+    struct Records
+    {
+        std::vector<Record> records;
+        std::vector<char>   paths;
+    };
+
+    // What the hash and tag indexes need from a preset file, kept across
+    // refreshes so only files that changed are parsed again
+    struct IndexEntry
+    {
+        juce::Time          modified;
+        juce::int64         size = 0;
+        juce::uint64        hash = 0;
+        juce::StringArray   tags;
+        int                 migratedTo = 0;
+        bool                loaded = false;
+    };
+
+private:
+    void ensureScanned();
+    Records findPresets (const juce::File&, juce::StringArray& banks,
+                         juce::HashMap<juce::String, int>& bankIndexes) const;
+    Records findEmbeddedPresets (juce::StringArray& banks,
+                                 juce::HashMap<juce::String, int>& bankIndexes) const;
+    Preset makePreset (const juce::File& location, const Records&, size_t recordIndex) const;
+    Preset getPresetUnlocked (int index) const;
+    int getNumPresetsUnlocked() const;
+    int indexOfFileUnlocked (const juce::File&) const;
+    void ensureIndexed (const PresetMigrator* = nullptr);
+    void indexPreset (int slot, const Preset&);
+    void indexSlot (int slot, juce::uint64 hash, const juce::StringArray& tags);
+    static IndexEntry readIndexEntry (const Preset&, const PresetMigrator*);
+    void insertIndexSlot (int position);
+    static int insertRecord (Records&, const juce::String& relativePath, int bankIndex, juce::int64 modified);
+    juce::File getFavouritesFile() const;
+    juce::String getFavouriteKey (const juce::File&) const;
+    juce::File getFavouriteFile (const juce::String& key) const;
+
+private:
+
+    typedef juce::ListenerList<Listener, juce::Array<Listener*, juce::CriticalSection>> Listeners;
+
+    // The hash and tag indexes refer to presets by slot, which stays stable
+    // when a saved preset is inserted and shifts the record positions.
+    // Lock order: mScanLock, then mIndexLock, then mLock. Index queries call
+    // ensureScanned() before taking mIndexLock so they never wait on a scan
+    // while holding it, and ensureIndexed() parses files with it released.
+    // mOrderLock is taken before mLock; navigation orders are rebuilt when
+    // mGeneration, bumped on every change, has moved on.
+    juce::ReadWriteLock     mLock;
+    juce::CriticalSection   mScanLock;
+    std::atomic<bool>       mScanned;
+    Records                 mFactoryPresets;
+    Records                 mUserPresets;
+    juce::StringArray       mBanks;
+    juce::StringArray       mFavourites;        // "user:" or "factory:" and the relative path
+    juce::CriticalSection   mIndexLock;
+    bool                    mIndexed;
+    int                     mIndexVersion;      // migrated to, 0 if not
+    std::unordered_map<juce::uint64, juce::Array<int>> mHashIndex;
+    std::vector<juce::uint64> mPresetHashes;     // by slot
+    std::vector<int>        mSlotPositions;     // index slot -> record position
+    std::vector<int>        mPositionSlots;     // record position -> index slot
+    PresetTagIndex          mTagIndex;
+    juce::HashMap<juce::String, IndexEntry> mIndexCache;    // by full path
+    std::atomic<juce::uint32> mGeneration;
+    juce::CriticalSection   mOrderLock;
+    std::map<juce::String, std::shared_ptr<const PresetNavigator::Order>> mNavigationOrders;
+    Listeners               mListeners;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PresetCatalogue)
+};
+
+//==============================================================================
+
+} // namespace presets
+} // namespace grape
@@ -27,6 +27,7 @@
 //==============================================================================
 
 #include <grape/presets/PresetChecker.h>
+#include <grape/helpers/Profiler.h>
 #include <grape/presets/PresetManager.h>
 
 //==============================================================================
@@ -51,6 +52,8 @@ PresetChecker::~PresetChecker()
 
 void PresetChecker::timerCallback()
 {
+    GRAPE_PROFILE_SCOPE ("PresetChecker::timerCallback");
+
     mPresetManager.checkPresetChanged();
 }
 
@@ -0,0 +1,215 @@
+/*
+    GRAPE is Romain's Audio Plug-in Extension classes for the JUCE framework
+
+    Copyright (c) 2018 Romain Clement
+
+    MIT License    
+    
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+    
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+ */
+
+//==============================================================================
+
+#include <grape/presets/PresetImporter.h>
+#include <grape/helpers/Helpers.h>
+#include <grape/helpers/Profiler.h>
+#include <grape/helpers/RealtimeGuard.h>
+
+//==============================================================================
+
+namespace grape {
+namespace presets {
+
+//==============================================================================
+
+PresetImporter::PresetImporter (const juce::File& destinationLocation)
+    : mDestinationLocation (destinationLocation)
+{
+
+}
+
+PresetImporter::~PresetImporter()
+{
+
+}
+
+//==============================================================================
+
+PresetImporter::Result PresetImporter::importFrom (const juce::File& source,
+                                                   const juce::String& bank,
+                                                   int numThreads)
+{
+    GRAPE_ASSERT_NON_REALTIME ("PresetImporter::importFrom");
+    GRAPE_PROFILE_SCOPE ("PresetImporter::importFrom");
+
+    mItems.clear();
+    mReservedTargets.clear();
+
+    if (source.isDirectory())
+        collectFromDirectory (source, bank);
+    else if (source.hasFileExtension ("zip"))
+        collectFromZip (source, bank);
+
+    Result result;
+    if (mItems.isEmpty())
+        return result;
+
+    std::atomic<int> numImported (0);
+    std::atomic<int> numRejected (0);
+    std::atomic<int> numFailed (0);
+    std::atomic<int> numRemaining (mItems.size());
+    juce::WaitableEvent finished;
+
+    {
+        juce::ThreadPool pool (numThreads > 0 ? numThreads : juce::SystemStats::getNumCpus());
+
+        for (auto* item : mItems)
+        {
+            pool.addJob ([this, item, &numImported, &numRejected, &numFailed, &numRemaining, &finished]
+            {
+                // Each job reads its own file or zip entry, so only the
+                // presets being imported right now are held in memory
+                juce::MemoryBlock data;
+
+                if (!readItem (*item, data))
+                {
+                    ++numFailed;
+                }
+                else if (!Preset().loadFromData (data.getData(), data.getSize()))
+                {
+                    ++numRejected;
+                }
+                else
+                {
+                    const auto parentDir = item->targetFile.getParentDirectory();
+                    if (!parentDir.exists())
+                        parentDir.createDirectory();
+
+                    if (helpers::replaceFileAtomically (item->targetFile, data.getData(), data.getSize()))
+                        ++numImported;
+                    else
+                        ++numFailed;
+                }
+
+                if (--numRemaining == 0)
+                    finished.signal();
+            });
+        }
+
+        finished.wait();
+    }
+
+    mItems.clear();
+    mReservedTargets.clear();
+    mZip.reset();
+
+    result.numImported = numImported.load();
+    result.numRejected = numRejected.load();
+    result.numFailed = numFailed.load();
+    return result;
+}
+
+//==============================================================================
+
+void PresetImporter::collectFromDirectory (const juce::File& directory, const juce::String& bank)
+{
+    const auto files = directory.findChildFiles (
+        juce::File::TypesOfFileToFind::findFiles, true, "*.xml"
+    );
+
+    for (const auto& f : files)
+    {
+        addItem (f.getRelativePathFrom (directory), bank, f, -1);
+    }
+}
+
+void PresetImporter::collectFromZip (const juce::File& zipFile, const juce::String& bank)
+{
+    // A zip opened from a file gives every entry stream its own file handle,
+    // so the jobs can read entries in parallel
+    mZip.reset (new juce::ZipFile (zipFile));
+
+    for (int i = 0; i < mZip->getNumEntries(); ++i)
+    {
+        const auto entry = mZip->getEntry (i);
+        if (entry == nullptr || !entry->filename.endsWithIgnoreCase (".xml") || entry->uncompressedSize <= 0)
+            continue;
+
+        addItem (entry->filename, bank, juce::File(), i);
+    }
+}
+
+bool PresetImporter::readItem (const Item& item, juce::MemoryBlock& data) const
+{
+    if (item.zipEntry < 0)
+        return item.sourceFile.loadFileAsData (data);
+
+    std::unique_ptr<juce::InputStream> stream (mZip->createStreamForEntry (item.zipEntry));
+    return stream != nullptr && stream->readIntoMemoryBlock (data) > 0;
+}
+
+void PresetImporter::addItem (const juce::String& relativePath,
+                              const juce::String& bank,
+                              const juce::File& sourceFile,
+                              int zipEntry)
+{
+    const auto path = relativePath.replaceCharacter ('\\', '/');
+    const auto name = path.fromLastOccurrenceOf ("/", false, false).upToLastOccurrenceOf (".", false, false);
+    const auto itemBank = (
+        bank.isNotEmpty() || !path.containsChar ('/')
+        ? bank
+        : path.upToFirstOccurrenceOf ("/", false, false)
+    );
+
+    if (name.isEmpty())
+        return;
+
+    auto item = new Item();
+    item->sourceFile = sourceFile;
+    item->zipEntry = zipEntry;
+    item->targetFile = findTargetFile (itemBank, name);
+    mItems.add (item);
+}
+
+juce::File PresetImporter::findTargetFile (const juce::String& bank, const juce::String& name)
+{
+    const auto bankLocation = (
+        bank.isNotEmpty()
+        ? mDestinationLocation.getChildFile (juce::File::createLegalFileName (bank))
+        : mDestinationLocation
+    );
+
+    const auto legalName = juce::File::createLegalFileName (name);
+    auto target = bankLocation.getChildFile (legalName).withFileExtension ("xml");
+
+    for (int suffix = 2; target.exists() || mReservedTargets.contains (target.getFullPathName()); ++suffix)
+    {
+        target = bankLocation
+            .getChildFile (legalName + " (" + juce::String (suffix) + ")")
+            .withFileExtension ("xml");
+    }
+
+    mReservedTargets.set (target.getFullPathName(), true);
+    return target;
+}
+
+//==============================================================================
+
+} // namespace presets
+} // namespace grape
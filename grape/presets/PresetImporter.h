@@ -0,0 +1,88 @@
+/*
+    GRAPE is Romain's Audio Plug-in Extension classes for the JUCE framework
+
+    Copyright (c) 2018 Romain Clement
+
+    MIT License    
+    
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+    
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+ */
+
+//==============================================================================
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <grape/presets/Preset.h>
+
+//==============================================================================
+
+namespace grape {
+namespace presets {
+
+//==============================================================================
+
+class PresetImporter
+{
+public:
+    struct Result
+    {
+        int numImported = 0;
+        int numRejected = 0;
+        int numFailed = 0;
+    };
+
+public:
+    PresetImporter (const juce::File& destinationLocation);
+    ~PresetImporter();
+
+public:
+    Result importFrom (const juce::File& source,
+                       const juce::String& bank = juce::String(),
+                       int numThreads = 0);
+
+private:
+    struct Item
+    {
+        juce::File          sourceFile;
+        int                 zipEntry = -1;
+        juce::File          targetFile;
+    };
+
+private:
+    void collectFromDirectory (const juce::File& directory, const juce::String& bank);
+    void collectFromZip (const juce::File& zipFile, const juce::String& bank);
+    void addItem (const juce::String& relativePath, const juce::String& bank,
+                  const juce::File& sourceFile, int zipEntry);
+    bool readItem (const Item&, juce::MemoryBlock&) const;
+    juce::File findTargetFile (const juce::String& bank, const juce::String& name);
+
+private:
+    const juce::File                    mDestinationLocation;
+    std::unique_ptr<juce::ZipFile>      mZip;
+    juce::OwnedArray<Item>              mItems;
+    juce::HashMap<juce::String, bool>   mReservedTargets;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PresetImporter)
+};
+
+//==============================================================================
+
+} // namespace presets
+} // namespace grape
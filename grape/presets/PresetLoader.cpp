@@ -0,0 +1,321 @@
+/*
+    GRAPE is Romain's Audio Plug-in Extension classes for the JUCE framework
+
+    Copyright (c) 2018 Romain Clement
+
+    MIT License    
+    
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+    
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+ */
+
+//==============================================================================
+
+#include <grape/presets/PresetLoader.h>
+#include <grape/helpers/Profiler.h>
+#include <grape/helpers/RealtimeGuard.h>
+#include <algorithm>
+
+//==============================================================================
+
+namespace grape {
+namespace presets {
+
+//==============================================================================
+
+constexpr int PresetLoader::queueSize;
+constexpr juce::uint32 PresetLoader::audioTimeoutMilliseconds;
+constexpr juce::uint32 PresetLoader::drainTimeoutMilliseconds;
+constexpr int PresetLoader::pollIntervalMilliseconds;
+
+//==============================================================================
+
+namespace {
+
+bool isJobExiting()
+{
+    const auto* job = juce::ThreadPoolJob::getCurrentThreadPoolJob();
+    return job != nullptr && job->shouldExit();
+}
+
+} // namespace
+
+//==============================================================================
+
+PresetLoader::PresetLoader (parameters::ParameterManager& parameterManager,
+                            PresetMigrator& migrator,
+                            juce::ThreadPool& threadPool,
+                            Callback onPresetApplied)
+    : mParameterManager (parameterManager)
+    , mMigrator (migrator)
+    , mThreadPool (threadPool)
+    , mOnPresetApplied (onPresetApplied)
+    , mNumParameters (parameterManager.getNumParameters())
+    , mFifo (queueSize)
+    , mSlots (queueSize)
+    , mRampStart (static_cast<size_t> (mNumParameters))
+    , mRampTarget (static_cast<size_t> (mNumParameters))
+    , mRampValues (static_cast<size_t> (mNumParameters))
+    , mRampLength (0)
+    , mRampPosition (0)
+    , mRamping (false)
+    , mRampSequence (0)
+    , mNextSequence (0)
+    , mReadSequence (0)
+    , mAppliedSequence (0)
+    , mCancelledSequence (0)
+    , mLastProcessTime (0)
+    , mNumParsing (0)
+{
+    for (auto& slot : mSlots)
+    {
+        slot.values.resize (static_cast<size_t> (mNumParameters));
+    }
+
+    for (int i = 0; i < mNumParameters; ++i)
+    {
+        const auto& info = mParameterManager.getParameterInfo (i);
+        mIsDiscrete.push_back (info.isDiscrete || info.isBoolean);
+    }
+}
+
+PresetLoader::~PresetLoader()
+{
+    stopTimer();
+}
+
+//==============================================================================
+
+bool PresetLoader::isAudioActive() const
+{
+    const auto lastProcessTime = mLastProcessTime.load();
+    return lastProcessTime != 0
+        && juce::Time::getMillisecondCounter() - lastProcessTime < audioTimeoutMilliseconds;
+}
+
+void PresetLoader::loadPreset (const Preset& preset)
+{
+    const auto sequence = ++mNextSequence;
+
+    ++mNumParsing;
+    startTimer (pollIntervalMilliseconds);
+
+    mThreadPool.addJob ([this, preset, sequence]
+    {
+        GRAPE_PROFILE_SCOPE ("PresetLoader::parse");
+
+        auto loadedPreset = preset;
+        if (sequence > mCancelledSequence.load()
+            && !isJobExiting()
+            && mMigrator.loadPreset (loadedPreset)
+            && sequence == mNextSequence.load()
+            && !isJobExiting())
+        {
+            std::vector<float> values;
+            buildValues (loadedPreset, values);
+
+            GRAPE_SCOPED_LOCK (juce::ScopedLock, mPendingLock);
+
+            if (sequence > mCancelledSequence.load())
+            {
+                // Older loads still waiting are superseded by this one
+                mPendingLoads.erase (mPendingLoads.begin(), mPendingLoads.lower_bound (sequence));
+
+                auto& pending = mPendingLoads[sequence];
+                pending.preset = loadedPreset;
+                pending.values = std::move (values);
+                pending.queuedTime = juce::Time::getMillisecondCounter();
+                pending.pushed = pushValues (sequence, pending.values);
+            }
+        }
+
+        --mNumParsing;
+    });
+}
+
+void PresetLoader::cancelPendingLoads()
+{
+    mCancelledSequence = mNextSequence.load();
+
+    GRAPE_SCOPED_LOCK (juce::ScopedLock, mPendingLock);
+    mPendingLoads.clear();
+}
+
+void PresetLoader::process (int numSamples)
+{
+    mLastProcessTime = juce::jmax (juce::Time::getMillisecondCounter(), static_cast<juce::uint32> (1));
+
+    const auto cancelledSequence = mCancelledSequence.load();
+
+    const auto numReady = mFifo.getNumReady();
+    if (numReady > 0)
+    {
+        int start1, size1, start2, size2;
+        mFifo.prepareToRead (numReady, start1, size1, start2, size2);
+
+        const auto latest = size2 > 0 ? start2 + size2 - 1 : start1 + size1 - 1;
+        const auto& slot = mSlots[static_cast<size_t> (latest)];
+
+        // Loads the message thread already applied synchronously are dropped
+        if (slot.sequence > cancelledSequence)
+        {
+            std::copy (slot.values.begin(), slot.values.end(), mRampTarget.begin());
+            mParameterManager.copyValues (mRampStart.data());
+            mRampSequence = slot.sequence;
+            mRampPosition = 0;
+            mRamping = true;
+            mReadSequence = slot.sequence;
+        }
+
+        mFifo.finishedRead (size1 + size2);
+    }
+
+    if (mRamping && mRampSequence <= cancelledSequence)
+        mRamping = false;
+
+    if (!mRamping)
+        return;
+
+    const auto rampLength = mRampLength.load();
+    mRampPosition += numSamples;
+
+    const auto t = (
+        rampLength > 0
+        ? juce::jmin (1.0f, static_cast<float> (mRampPosition) / static_cast<float> (rampLength))
+        : 1.0f
+    );
+
+    for (size_t i = 0; i < mRampValues.size(); ++i)
+    {
+        mRampValues[i] = (
+            mIsDiscrete[i]
+            ? mRampTarget[i]
+            : mRampStart[i] + (mRampTarget[i] - mRampStart[i]) * t
+        );
+    }
+
+    // Hosts and listeners are notified once the message thread adopts the preset
+    mParameterManager.applyValues (mRampValues.data(), false);
+
+    if (t >= 1.0f)
+    {
+        mRamping = false;
+        mAppliedSequence = mRampSequence;
+    }
+}
+
+//==============================================================================
+
+void PresetLoader::timerCallback()
+{
+    const auto appliedSequence = mAppliedSequence.load();
+
+    Preset appliedPreset;
+    auto applied = false;
+
+    {
+        GRAPE_SCOPED_LOCK (juce::ScopedLock, mPendingLock);
+
+        for (auto it = mPendingLoads.begin(); it != mPendingLoads.end() && it->first <= appliedSequence;)
+        {
+            if (it->first == appliedSequence)
+            {
+                appliedPreset = it->second.preset;
+                applied = true;
+            }
+
+            it = mPendingLoads.erase (it);
+        }
+
+        if (!mPendingLoads.empty())
+        {
+            const auto sequence = mPendingLoads.rbegin()->first;
+            auto& pending = mPendingLoads.rbegin()->second;
+
+            if (!pending.pushed)
+                pending.pushed = pushValues (sequence, pending.values);
+
+            const auto drained = mReadSequence.load() >= sequence;
+            const auto elapsed = juce::Time::getMillisecondCounter() - pending.queuedTime;
+
+            // The audio thread stopped, or never picked the values up: apply
+            // the preset here rather than leaving it stuck in the queue.
+            if (!isAudioActive() || (!drained && elapsed > drainTimeoutMilliseconds))
+            {
+                appliedPreset = pending.preset;
+                applied = true;
+
+                mCancelledSequence = sequence;
+                mPendingLoads.clear();
+            }
+        }
+
+        if (mPendingLoads.empty() && mNumParsing.load() == 0)
+            stopTimer();
+    }
+
+    if (applied && mOnPresetApplied != nullptr)
+        mOnPresetApplied (appliedPreset);
+}
+
+//==============================================================================
+
+void PresetLoader::buildValues (const Preset& preset, std::vector<float>& values) const
+{
+    values.resize (static_cast<size_t> (mNumParameters));
+
+    for (int i = 0; i < mNumParameters; ++i)
+    {
+        values[static_cast<size_t> (i)] = mParameterManager.getParameterByIndex (i)->getDefaultValue();
+    }
+
+    const auto& state = preset.getState();
+    for (int c = 0; c < state.getNumChildren(); ++c)
+    {
+        const auto child = state.getChild (c);
+        const auto index = mParameterManager.indexOfParameter (child.getProperty ("id").toString());
+
+        if (index >= 0)
+        {
+            const auto& range = mParameterManager.getParameterInfo (index).valueRange;
+            const auto value = static_cast<float> (static_cast<double> (child.getProperty ("value")));
+            values[static_cast<size_t> (index)] = range.convertTo0to1 (value);
+        }
+    }
+}
+
+bool PresetLoader::pushValues (juce::uint32 sequence, const std::vector<float>& values)
+{
+    if (mFifo.getFreeSpace() == 0)
+        return false;
+
+    int start1, size1, start2, size2;
+    mFifo.prepareToWrite (1, start1, size1, start2, size2);
+
+    auto& slot = mSlots[static_cast<size_t> (start1)];
+    slot.sequence = sequence;
+    std::copy (values.begin(), values.end(), slot.values.begin());
+
+    mFifo.finishedWrite (1);
+    return true;
+}
+
+//==============================================================================
+
+} // namespace presets
+} // namespace grape
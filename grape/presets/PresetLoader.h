@@ -0,0 +1,131 @@
+/*
+    GRAPE is Romain's Audio Plug-in Extension classes for the JUCE framework
+
+    Copyright (c) 2018 Romain Clement
+
+    MIT License    
+    
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+    
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+ */
+
+//==============================================================================
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <grape/presets/Preset.h>
+#include <grape/presets/PresetMigrator.h>
+#include <grape/parameters/ParameterManager.h>
+#include <atomic>
+#include <map>
+#include <vector>
+
+//==============================================================================
+
+namespace grape {
+namespace presets {
+
+//==============================================================================
+
+class PresetLoader : private juce::Timer
+{
+public:
+    using Callback = std::function<void (const Preset&)>;
+
+public:
+    PresetLoader (parameters::ParameterManager&,
+                  PresetMigrator&,
+                  juce::ThreadPool&,
+                  Callback onPresetApplied);
+    ~PresetLoader();
+
+public:
+    inline void setRampLength (int numSamples) { mRampLength = juce::jmax (numSamples, 0); }
+    inline int getRampLength() const { return mRampLength.load(); }
+
+    bool isAudioActive() const;
+    void loadPreset (const Preset&);
+    void cancelPendingLoads();
+    void process (int numSamples);
+
+private: // juce::Timer
+    void timerCallback() override;
+
+private:
+    struct Slot
+    {
+        juce::uint32 sequence = 0;
+        std::vector<float> values;
+    };
+
+    struct PendingLoad
+    {
+        Preset              preset;
+        std::vector<float>  values;
+        juce::uint32        queuedTime;
+        bool                pushed;
+    };
+
+    static constexpr int queueSize = 4;
+    static constexpr juce::uint32 audioTimeoutMilliseconds = 250;
+    static constexpr juce::uint32 drainTimeoutMilliseconds = 500;
+    static constexpr int pollIntervalMilliseconds = 20;
+
+private:
+    void buildValues (const Preset&, std::vector<float>& values) const;
+    bool pushValues (juce::uint32 sequence, const std::vector<float>& values);
+
+private:
+    parameters::ParameterManager&   mParameterManager;
+    PresetMigrator&                 mMigrator;
+    juce::ThreadPool&               mThreadPool;
+    Callback                        mOnPresetApplied;
+    const int                       mNumParameters;
+
+    juce::AbstractFifo              mFifo;
+    std::vector<Slot>               mSlots;
+    std::vector<bool>               mIsDiscrete;
+
+    std::vector<float>              mRampStart;
+    std::vector<float>              mRampTarget;
+    std::vector<float>              mRampValues;
+    std::atomic<int>                mRampLength;
+    int                             mRampPosition;
+    bool                            mRamping;
+    juce::uint32                    mRampSequence;
+
+    std::atomic<juce::uint32>       mNextSequence;
+    std::atomic<juce::uint32>       mReadSequence;
+    std::atomic<juce::uint32>       mAppliedSequence;
+    std::atomic<juce::uint32>       mCancelledSequence;
+    std::atomic<juce::uint32>       mLastProcessTime;
+    std::atomic<int>                mNumParsing;
+
+    // Guards the pending loads and serialises pushes into mFifo, which may
+    // come from the worker or from the message thread.
+    juce::CriticalSection           mPendingLock;
+    std::map<juce::uint32, PendingLoad> mPendingLoads;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PresetLoader)
+};
+
+//==============================================================================
+
+} // namespace presets
+} // namespace grape
@@ -27,6 +27,8 @@
 //==============================================================================
 
 #include <grape/presets/PresetManager.h>
+#include <grape/helpers/Profiler.h>
+#include <grape/helpers/RealtimeGuard.h>
 
 //==============================================================================
 
@@ -35,76 +37,108 @@ namespace presets {
 
 //==============================================================================
 
-static bool isMacOS ()
-{
-    static const bool macOS = (
-        (juce::SystemStats::getOperatingSystemType()
-         & juce::SystemStats::OperatingSystemType::MacOSX) != 0
-    );
-
-    return macOS;
-}
-
-//==============================================================================
-
 PresetManager::PresetManager (parameters::ParameterManager& parameterManager)
     : mParameterManager (parameterManager)
+    , mNavigatorDirty (true)
+    , mSelectionSequence (0)
+    , mCurrentPresetIndex (-1)
+    , mCurrentPresetIndexDirty (true)
+    , mCurrentCompareSlot (0)
+    , mLastCheckedPresetHash (0)
+    , mLastCheckedParametersHash (0)
+    , mLastCheckedDifferent (false)
     , mPresetChecker (*this)
+    , mNumPendingSaves (0)
+    , mWorkerPool (1)
+    , mLoader (mParameterManager, mMigrator, mWorkerPool, [this] (const Preset& p) { adoptLoadedPreset (p); })
 {
-    loadDefaultPreset();
+    mCatalogue->addListener (this);
+    setNumCompareSlots (2);
+
+    // Parameters already hold their defaults and the host usually restores a
+    // session right away, so neither reset them nor scan the catalogue here.
+    mCurrentPreset = createDefaultPreset();
 }
 
 PresetManager::~PresetManager()
 {
+    // Queued loads become no-ops once cancelled, but queued saves must still
+    // reach the disk: wait for them before interrupting what is left.
+    mLoader.cancelPendingLoads();
+
+    while (mNumPendingSaves.load() > 0 && mSavesFinished.wait (workerTimeoutMilliseconds)) {}
 
+    const auto finished = mWorkerPool.removeAllJobs (true, workerTimeoutMilliseconds);
+    jassert (finished);
+    juce::ignoreUnused (finished);
+
+    mCatalogue->removeListener (this);
 }
 
 //==============================================================================
 
 juce::File PresetManager::getFactoryPresetsLocation() const
 {
-    static const auto location = juce::File::getSpecialLocation (
-        juce::File::SpecialLocationType::commonApplicationDataDirectory
-    )
-    .getChildFile (isMacOS() ? "Application Support" : "")
-    .getChildFile (JucePlugin_Manufacturer)
-    .getChildFile (JucePlugin_Name)
-    .getChildFile ("presets");
-
-    return location;
+    return mCatalogue->getFactoryPresetsLocation();
 }
 
 juce::File PresetManager::getUserPresetsLocation() const
 {
-    static const auto location = juce::File::getSpecialLocation (
-        juce::File::SpecialLocationType::userApplicationDataDirectory
-    )
-    .getChildFile (isMacOS() ? "Application Support" : "")
-    .getChildFile (JucePlugin_Manufacturer)
-    .getChildFile (JucePlugin_Name)
-    .getChildFile ("presets");
-
-    if (!location.exists())
-        location.createDirectory();
-
-    return location;
+    return mCatalogue->getUserPresetsLocation();
 }
 
 juce::Array<Preset> PresetManager::getFactoryPresets() const
 {
-    return findPresets (getFactoryPresetsLocation());
+    return mCatalogue->getFactoryPresets();
 }
 
 juce::Array<Preset> PresetManager::getUserPresets() const
 {
-    return findPresets (getUserPresetsLocation());
+    return mCatalogue->getUserPresets();
 }
 
 juce::Array<Preset> PresetManager::getAllPresets() const
 {
-    auto allPresets = getFactoryPresets();
-    allPresets.addArray (getUserPresets());
-    return allPresets;
+    return mCatalogue->getAllPresets();
+}
+
+void PresetManager::refreshPresets()
+{
+    GRAPE_ASSERT_NON_REALTIME ("PresetManager::refreshPresets");
+
+    mCatalogue->refresh();
+    invalidateCurrentPresetIndex();
+}
+
+PresetImporter::Result PresetManager::importPresets (const juce::File& source,
+                                                    const juce::String& presetBank)
+{
+    PresetImporter importer (getUserPresetsLocation());
+    const auto result = importer.importFrom (source, presetBank);
+
+    if (result.numImported > 0)
+        refreshPresets();
+
+    return result;
+}
+
+juce::StringArray PresetManager::getAllPresetTags() const
+{
+    return mCatalogue->getAllTags();
+}
+
+juce::Array<Preset> PresetManager::findPresetsWithTags (const juce::StringArray& allOf,
+                                                        const juce::StringArray& anyOf,
+                                                        const juce::StringArray& noneOf) const
+{
+    return mCatalogue->findPresetsWithTags (allOf, anyOf, noneOf);
+}
+
+int PresetManager::countPresetsWithTags (const juce::StringArray& allOf,
+                                         const juce::StringArray& anyOf,
+                                         const juce::StringArray& noneOf) const
+{
+    return mCatalogue->countPresetsWithTags (allOf, anyOf, noneOf);
 }
 
 Preset PresetManager::getFactoryPreset (const juce::String& presetName,
@@ -130,7 +164,7 @@ Preset PresetManager::getFactoryPreset (const juce::String& presetName,
             .withFileExtension ("xml")
     );
 
-    const auto bank = findPresetBank (factoryPresetFile, factoryLocation);
+    const auto bank = mCatalogue->findPresetBank (factoryPresetFile, factoryLocation);
     return Preset (factoryPresetFile);
 }
 
@@ -157,7 +191,7 @@ Preset PresetManager::getUserPreset (const juce::String& presetName,
             .withFileExtension ("xml")
     );
 
-    const auto bank = findPresetBank (userPresetFile, userLocation);
+    const auto bank = mCatalogue->findPresetBank (userPresetFile, userLocation);
     return Preset (userPresetFile, bank);
 }
 
@@ -168,68 +202,165 @@ Preset PresetManager::getCurrentPreset() const
 
 void PresetManager::loadDefaultPreset()
 {
+    GRAPE_ASSERT_NON_REALTIME ("PresetManager::loadDefaultPreset");
+
+    mLoader.cancelPendingLoads();
     mParameterManager.resetAll();
 
-    mCurrentPreset = Preset();
-    mCurrentPreset.setName ("Default");
-    mCurrentPreset.replaceState (mParameterManager.copyState());
-    findCurrentPresetIndex();
+    mCurrentPreset = createDefaultPreset();
+    ++mSelectionSequence;
+    invalidateCurrentPresetIndex();
 
     notifyPresetChanged();
 }
 
 void PresetManager::loadPreset (const Preset& preset)
 {
+    GRAPE_ASSERT_NON_REALTIME ("PresetManager::loadPreset");
+
+    mLoader.cancelPendingLoads();
+
     auto loadedPreset = preset;
-    if (loadedPreset.loadFromFile())
+    if (mMigrator.loadPreset (loadedPreset))
     {
         mCurrentPreset = loadedPreset;
         mParameterManager.replaceState (mCurrentPreset.copyState());
-        findCurrentPresetIndex();
+        ++mSelectionSequence;
+        invalidateCurrentPresetIndex();
         notifyPresetChanged();
     }
 }
 
+void PresetManager::loadPresetAsync (const Preset& preset)
+{
+    GRAPE_ASSERT_NON_REALTIME ("PresetManager::loadPresetAsync");
+
+    // Saves finishing while the load is in flight no longer select their preset
+    ++mSelectionSequence;
+
+    if (mLoader.isAudioActive())
+        mLoader.loadPreset (preset);
+    else
+        loadPreset (preset);
+}
+
+void PresetManager::processPendingLoads (int numSamples)
+{
+    mLoader.process (numSamples);
+}
+
 void PresetManager::loadPreviousPreset()
 {
-    loadPresetAtIndex (mCurrentPresetIndex - 1);
+    loadPresetAtIndex (getCurrentPresetIndex() - 1);
 }
 
 void PresetManager::loadNextPreset()
 {
-    loadPresetAtIndex (mCurrentPresetIndex + 1);
+    loadPresetAtIndex (getCurrentPresetIndex() + 1);
 }
 
 bool PresetManager::canLoadPreviousPreset()
 {
-    return mCurrentPresetIndex > 0;
+    return getCurrentPresetIndex() > 0;
 }
 
 bool PresetManager::canLoadNextPreset()
 {
-    const auto allPresets = getAllPresets();
-    return mCurrentPresetIndex < (allPresets.size() - 1);
+    const auto currentIndex = getCurrentPresetIndex();
+    return currentIndex < (mNavigator.getNumPresets() - 1);
+}
+
+void PresetManager::setNavigationOrder (const juce::Array<PresetNavigator::SortKey>& sortKeys,
+                                        bool favouritesFirst)
+{
+    mNavigator.setSortOrder (sortKeys, favouritesFirst);
+    mNavigatorDirty = true;
+    invalidateCurrentPresetIndex();
+}
+
+int PresetManager::getCurrentPresetPosition()
+{
+    return getCurrentPresetIndex();
+}
+
+int PresetManager::getNumNavigablePresets()
+{
+    ensureNavigationOrder();
+    return mNavigator.getNumPresets();
+}
+
+bool PresetManager::isPresetFavourite (const Preset& preset) const
+{
+    return mCatalogue->isFavourite (preset);
+}
+
+void PresetManager::setPresetFavourite (const Preset& preset, bool favourite)
+{
+    mCatalogue->setFavourite (preset, favourite);
 }
 
 bool PresetManager::saveCurrentPreset (const juce::String& presetName,
                                        const juce::String& presetBank,
                                        const juce::String& presetAuthor,
-                                       const juce::String& presetComments)
+                                       const juce::String& presetComments,
+                                       const juce::StringArray& presetTags)
 {
-    auto userPreset = getUserPreset (presetName, presetBank);
-    userPreset.setAuthor (presetAuthor);
-    userPreset.setComments (presetComments);
-    userPreset.replaceState (mParameterManager.copyState());
+    GRAPE_ASSERT_NON_REALTIME ("PresetManager::saveCurrentPreset");
+
+    auto userPreset = createUserPresetSnapshot (
+        presetName, presetBank, presetAuthor, presetComments, presetTags
+    );
 
     if (userPreset.saveToFile())
     {
-        loadPreset (userPreset);
+        adoptSavedPreset (userPreset, mSelectionSequence);
         return true;
     }
 
     return false;
 }
 
+void PresetManager::saveCurrentPresetAsync (const juce::String& presetName,
+                                            const juce::String& presetBank,
+                                            const juce::String& presetAuthor,
+                                            const juce::String& presetComments,
+                                            const juce::StringArray& presetTags,
+                                            SaveCallback callback)
+{
+    GRAPE_ASSERT_NON_REALTIME ("PresetManager::saveCurrentPresetAsync");
+
+    const auto userPreset = createUserPresetSnapshot (
+        presetName, presetBank, presetAuthor, presetComments, presetTags
+    );
+
+    juce::WeakReference<PresetManager> weakThis (this);
+    const auto selectionSequence = mSelectionSequence;
+
+    ++mNumPendingSaves;
+
+    // The destructor waits for pending saves, so the job may use this
+    mWorkerPool.addJob ([this, weakThis, userPreset, selectionSequence, callback]
+    {
+        auto savedPreset = userPreset;
+        const auto saved = savedPreset.saveToFile();
+
+        if (--mNumPendingSaves == 0)
+            mSavesFinished.signal();
+
+        juce::MessageManager::callAsync ([weakThis, savedPreset, saved, selectionSequence, callback]
+        {
+            if (auto* presetManager = weakThis.get())
+            {
+                if (saved)
+                    presetManager->adoptSavedPreset (savedPreset, selectionSequence);
+            }
+
+            if (callback != nullptr)
+                callback (saved);
+        });
+    });
+}
+
 juce::XmlElement* PresetManager::toXml()
 {
     const auto xmlCurrentPreset = mCurrentPreset.toXml();
@@ -247,16 +378,99 @@ void PresetManager::fromXml (const juce::XmlElement& xmlState)
         const auto xmlPreset = xmlState.getChildElement (0);
         if (xmlPreset != nullptr && mCurrentPreset.fromXml (*xmlPreset))
         {
-            findCurrentPresetIndex();
+            ++mSelectionSequence;
+            invalidateCurrentPresetIndex();
             notifyPresetChanged();
         }
     }
 }
 
+void PresetManager::writeToStream (juce::OutputStream& output) const
+{
+    mCurrentPreset.writeToStream (output);
+}
+
+bool PresetManager::readFromStream (juce::InputStream& input, int formatVersion)
+{
+    if (mCurrentPreset.readFromStream (input, formatVersion))
+    {
+        ++mSelectionSequence;
+        invalidateCurrentPresetIndex();
+        notifyPresetChanged();
+        return true;
+    }
+
+    return false;
+}
+
+void PresetManager::writeXml (state::XmlStreamWriter& writer) const
+{
+    writer.startElement ("preset-manager");
+    mCurrentPreset.writeXml (writer);
+    writer.endElement ("preset-manager");
+}
+
+bool PresetManager::readXml (state::XmlStreamReader& reader)
+{
+    if (!reader.hasTagName ("preset-manager"))
+        return false;
+
+    auto loaded = false;
+
+    for (;;)
+    {
+        const auto token = reader.next();
+
+        if (token == state::XmlStreamReader::endElement)
+            break;
+
+        if (token != state::XmlStreamReader::startElement)
+            return false;
+
+        if (!loaded && reader.hasTagName ("preset"))
+        {
+            loaded = mCurrentPreset.readXml (reader);
+        }
+        else if (!reader.skipElement())
+        {
+            return false;
+        }
+    }
+
+    if (loaded)
+    {
+        ++mSelectionSequence;
+        invalidateCurrentPresetIndex();
+        notifyPresetChanged();
+    }
+
+    return true;
+}
+
 void PresetManager::checkPresetChanged ()
 {
-    const auto stateParameters = mParameterManager.copyState();
-    const auto different = !mCurrentPreset.checkState (stateParameters);
+    GRAPE_ASSERT_NON_REALTIME ("PresetManager::checkPresetChanged");
+    GRAPE_PROFILE_SCOPE ("PresetManager::checkPresetChanged");
+
+    // Equal hashes mean equal values. Different hashes can still come from
+    // values on either side of a quantisation step, so confirm with a
+    // tolerance, once per distinct pair of hashes.
+    const auto presetHash = mCurrentPreset.getContentHash();
+    const auto parametersHash = mParameterManager.getContentHash();
+
+    if (presetHash == parametersHash)
+    {
+        mLastCheckedDifferent = false;
+    }
+    else if (presetHash != mLastCheckedPresetHash || parametersHash != mLastCheckedParametersHash)
+    {
+        mLastCheckedDifferent = !mParameterManager.matchesState (mCurrentPreset.getState());
+    }
+
+    mLastCheckedPresetHash = presetHash;
+    mLastCheckedParametersHash = parametersHash;
+
+    const auto different = mLastCheckedDifferent;
     const auto modified = mCurrentPreset.isModified();
 
     if (modified != different)
@@ -266,73 +480,262 @@ void PresetManager::checkPresetChanged ()
     }
 }
 
-void PresetManager::addListener (Listener* listener)
+juce::Array<Preset> PresetManager::findPresetsMatchingCurrentState()
 {
-    mListeners.add (listener);
+    GRAPE_ASSERT_NON_REALTIME ("PresetManager::findPresetsMatchingCurrentState");
+
+    // The index hashes migrated presets, as loads see them. Hash hits are
+    // confirmed like in checkPresetChanged(), and the current preset is
+    // compared with a tolerance, since rounding of stored values can give
+    // it a different hash.
+    const auto candidates = mCatalogue->findPresetsWithHash (mParameterManager.getContentHash(), &mMigrator);
+
+    juce::Array<Preset> presets;
+    for (auto candidate : candidates)
+    {
+        if (mMigrator.loadPreset (candidate) && mParameterManager.matchesState (candidate.getState()))
+            presets.add (candidate);
+    }
+
+    const auto& currentFile = mCurrentPreset.getFile();
+    const auto listed = std::any_of (presets.begin(), presets.end(),
+                                     [&currentFile] (const Preset& p) { return p.getFile() == currentFile; });
+
+    if (!listed
+        && currentFile != juce::File()
+        && mCatalogue->indexOf (mCurrentPreset) >= 0
+        && mParameterManager.matchesState (mCurrentPreset.getState()))
+    {
+        presets.add (mCurrentPreset);
+    }
+
+    return presets;
 }
 
-void PresetManager::removeListener (Listener* listener)
+void PresetManager::setNumCompareSlots (int numSlots)
 {
-    mListeners.remove (listener);
+    const auto numParameters = static_cast<size_t> (mParameterManager.getNumParameters());
+
+    mCompareSlots.resize (static_cast<size_t> (juce::jmax (numSlots, 1)));
+    for (auto& slot : mCompareSlots)
+    {
+        slot.values.resize (numParameters);
+    }
+
+    mCurrentCompareSlot = juce::jmin (mCurrentCompareSlot, getNumCompareSlots() - 1);
 }
 
-//==============================================================================
+void PresetManager::selectCompareSlot (int slot)
+{
+    GRAPE_ASSERT_NON_REALTIME ("PresetManager::selectCompareSlot");
+
+    if (!juce::isPositiveAndBelow (slot, getNumCompareSlots()) || slot == mCurrentCompareSlot)
+        return;
+
+    storeCompareSlot (mCurrentCompareSlot);
+
+    auto& target = mCompareSlots[static_cast<size_t> (slot)];
+    if (target.isEmpty)
+    {
+        copyCompareSlot (mCurrentCompareSlot, slot);
+    }
+
+    mCurrentCompareSlot = slot;
+    mParameterManager.applyValues (target.values.data());
+    mCurrentPreset = target.preset;
+    ++mSelectionSequence;
+    invalidateCurrentPresetIndex();
+    notifyPresetChanged();
+}
 
-juce::Array<Preset> PresetManager::findPresets (const juce::File& location) const
+void PresetManager::copyCompareSlot (int sourceSlot, int destSlot)
 {
-    const auto presetFiles = location.findChildFiles (
-        juce::File::TypesOfFileToFind::findFiles, true, "*.xml"
-    );
+    if (!juce::isPositiveAndBelow (sourceSlot, getNumCompareSlots())
+        || !juce::isPositiveAndBelow (destSlot, getNumCompareSlots()))
+        return;
+
+    if (sourceSlot == mCurrentCompareSlot)
+        storeCompareSlot (sourceSlot);
 
-    juce::Array<Preset> presetsList;
-    for (auto& f : presetFiles)
+    const auto& source = mCompareSlots[static_cast<size_t> (sourceSlot)];
+    auto& dest = mCompareSlots[static_cast<size_t> (destSlot)];
+
+    std::copy (source.values.begin(), source.values.end(), dest.values.begin());
+    dest.preset = source.preset;
+    dest.isEmpty = source.isEmpty;
+
+    if (destSlot == mCurrentCompareSlot)
     {
-        const auto bank = findPresetBank (f, location);
-        presetsList.add (Preset (f, bank));
+        mParameterManager.applyValues (dest.values.data());
+        mCurrentPreset = dest.preset;
+        ++mSelectionSequence;
+        invalidateCurrentPresetIndex();
+        notifyPresetChanged();
     }
-    return presetsList;
 }
 
-juce::String PresetManager::findPresetBank (const juce::File& presetFile,
-                                            const juce::File& presetBaseLocation) const
+bool PresetManager::isCompareSlotModified (int slot) const
 {
-    auto bank = presetFile.getParentDirectory().getRelativePathFrom (presetBaseLocation);
+    if (slot == mCurrentCompareSlot)
+        return mCurrentPreset.isModified();
 
-    if (bank == ".")
-        return juce::String();
+    return juce::isPositiveAndBelow (slot, getNumCompareSlots())
+        && mCompareSlots[static_cast<size_t> (slot)].preset.isModified();
+}
+
+state::StateDiff PresetManager::getPresetChanges() const
+{
+    return mParameterManager.diffFrom (mCurrentPreset.getState());
+}
+
+void PresetManager::revertPresetChanges()
+{
+    applyPresetDiff (getPresetChanges().inverted());
+}
 
-    return bank.upToFirstOccurrenceOf ("/", false, false);
+void PresetManager::applyPresetDiff (const state::StateDiff& diff)
+{
+    mParameterManager.applyDiff (diff);
+    checkPresetChanged();
+}
+
+void PresetManager::addListener (Listener* listener)
+{
+    mListeners.add (listener);
 }
 
+void PresetManager::removeListener (Listener* listener)
+{
+    mListeners.remove (listener);
+}
+
+//==============================================================================
+
+void PresetManager::presetCatalogueChanged()
+{
+    GRAPE_PROFILE_SCOPE ("PresetManager::presetCatalogueChanged");
+
+    mNavigatorDirty = true;
+    invalidateCurrentPresetIndex();
+
+    mListeners.call (
+        [] (Listener& l) { l.presetsListChanged(); }
+    );
+}
+
+//==============================================================================
+
 void PresetManager::notifyPresetChanged ()
 {
+    GRAPE_PROFILE_SCOPE ("PresetManager::notifyPresetChanged");
+
     mListeners.call (
         [&] (Listener& l) { l.presetChanged (mCurrentPreset); }
     );
 }
 
-void PresetManager::findCurrentPresetIndex()
+void PresetManager::invalidateCurrentPresetIndex()
 {
-    const auto allPresets = getAllPresets();
+    mCurrentPresetIndexDirty = true;
+}
 
-    mCurrentPresetIndex = -1;
-    for (int i = 0; i < allPresets.size(); ++i)
+int PresetManager::getCurrentPresetIndex()
+{
+    ensureNavigationOrder();
+
+    if (mCurrentPresetIndexDirty)
     {
-        const auto& p = allPresets[i];
-        if (p == mCurrentPreset)
-        {
-            mCurrentPresetIndex = i;
-            return;
-        }
+        mCurrentPresetIndex = mNavigator.getPosition (mCatalogue->indexOf (mCurrentPreset));
+        mCurrentPresetIndexDirty = false;
     }
+
+    return mCurrentPresetIndex;
+}
+
+Preset PresetManager::createDefaultPreset()
+{
+    auto defaultPreset = Preset();
+    defaultPreset.setName ("Default");
+    defaultPreset.replaceState (mParameterManager.copyState());
+    return defaultPreset;
+}
+
+void PresetManager::ensureNavigationOrder()
+{
+    if (!mNavigatorDirty && mNavigator.isUpToDate (*mCatalogue))
+        return;
+
+    mNavigator.rebuild (*mCatalogue);
+    invalidateCurrentPresetIndex();
+
+    mNavigatorDirty = false;
+}
+
+Preset PresetManager::createUserPresetSnapshot (const juce::String& presetName,
+                                                const juce::String& presetBank,
+                                                const juce::String& presetAuthor,
+                                                const juce::String& presetComments,
+                                                const juce::StringArray& presetTags)
+{
+    auto userPreset = getUserPreset (presetName, presetBank);
+    userPreset.setAuthor (presetAuthor);
+    userPreset.setComments (presetComments);
+    userPreset.setTags (presetTags);
+    userPreset.setVersion (mMigrator.getCurrentVersion());
+    userPreset.setModified (false);
+    userPreset.replaceState (mParameterManager.copyState());
+    return userPreset;
+}
+
+void PresetManager::adoptSavedPreset (const Preset& savedPreset, juce::uint32 selectionSequence)
+{
+    mCatalogue->presetSaved (savedPreset);
+    mNavigatorDirty = true;
+
+    // Another preset was selected while the save was running: the file is
+    // in the library, but the selection stays
+    if (selectionSequence != mSelectionSequence)
+        return;
+
+    mCurrentPreset = savedPreset;
+    ++mSelectionSequence;
+    invalidateCurrentPresetIndex();
+    notifyPresetChanged();
+    checkPresetChanged();
+}
+
+void PresetManager::adoptLoadedPreset (const Preset& loadedPreset)
+{
+    // The audio thread only ramped the parameter values. Replacing the state
+    // skips values that are already current, so announce the ramped values
+    // first, then restore the rest, including non-parameter properties.
+    mParameterManager.notifyChangedValues();
+    mParameterManager.replaceState (loadedPreset.getState().createCopy());
+
+    mCurrentPreset = loadedPreset;
+    ++mSelectionSequence;
+    invalidateCurrentPresetIndex();
+    notifyPresetChanged();
 }
 
 void PresetManager::loadPresetAtIndex (int presetIndex)
 {
-    const auto allPresets = getAllPresets();
-    const auto numPresets = allPresets.size();
+    ensureNavigationOrder();
+
+    const auto numPresets = mNavigator.getNumPresets();
+    if (numPresets == 0)
+        return;
+
     const auto newPresetIndex = juce::jmin (juce::jmax (presetIndex, 0), numPresets - 1);
-    loadPreset (allPresets[newPresetIndex]);
+    loadPreset (mCatalogue->getPreset (mNavigator.getCatalogueIndex (newPresetIndex)));
+}
+
+void PresetManager::storeCompareSlot (int slot)
+{
+    auto& target = mCompareSlots[static_cast<size_t> (slot)];
+    mParameterManager.copyValues (target.values.data());
+    target.preset = mCurrentPreset;
+    target.isEmpty = false;
 }
 
 //==============================================================================
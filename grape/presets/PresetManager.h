@@ -30,8 +30,16 @@
 
 #include <JuceHeader.h>
 #include <grape/presets/Preset.h>
+#include <grape/presets/PresetCatalogue.h>
 #include <grape/presets/PresetChecker.h>
+#include <grape/presets/PresetImporter.h>
+#include <grape/presets/PresetLoader.h>
+#include <grape/presets/PresetMigrator.h>
+#include <grape/presets/PresetNavigator.h>
 #include <grape/parameters/ParameterManager.h>
+#include <algorithm>
+#include <atomic>
+#include <vector>
 
 //==============================================================================
 
@@ -40,7 +48,7 @@ namespace presets {
 
 //==============================================================================
 
-class PresetManager
+class PresetManager : private PresetCatalogue::Listener
 {
 public:
     class Listener
@@ -50,8 +58,11 @@ public:
 
     public:
         virtual void presetChanged (const Preset&) = 0;
+        virtual void presetsListChanged() {}
     };
 
+    using SaveCallback = std::function<void (bool)>;
+
 public:
     PresetManager (parameters::ParameterManager&);
     ~PresetManager();
@@ -63,6 +74,17 @@ public:
     juce::Array<Preset> getFactoryPresets() const;
     juce::Array<Preset> getUserPresets() const;
     juce::Array<Preset> getAllPresets() const;
+    void refreshPresets();
+    PresetImporter::Result importPresets (const juce::File& source,
+                                          const juce::String& presetBank = juce::String());
+
+    juce::StringArray getAllPresetTags() const;
+    juce::Array<Preset> findPresetsWithTags (const juce::StringArray& allOf,
+                                             const juce::StringArray& anyOf = juce::StringArray(),
+                                             const juce::StringArray& noneOf = juce::StringArray()) const;
+    int countPresetsWithTags (const juce::StringArray& allOf,
+                              const juce::StringArray& anyOf = juce::StringArray(),
+                              const juce::StringArray& noneOf = juce::StringArray()) const;
 
     Preset getFactoryPreset (const juce::String& presetName,
                              const juce::String& presetBank) const;
@@ -70,39 +92,114 @@ public:
                           const juce::String& presetBank) const;
     Preset getCurrentPreset() const;
 
+    inline PresetMigrator& getMigrator() { return mMigrator; }
+
     void loadDefaultPreset();
     void loadPreset (const Preset&);
+    void loadPresetAsync (const Preset&);
+    void processPendingLoads (int numSamples);
+    inline void setLoadRampLength (int numSamples) { mLoader.setRampLength (numSamples); }
     void loadPreviousPreset();
     void loadNextPreset();
     bool canLoadPreviousPreset();
     bool canLoadNextPreset();
+
+    void setNavigationOrder (const juce::Array<PresetNavigator::SortKey>& sortKeys, bool favouritesFirst);
+    int getCurrentPresetPosition();
+    int getNumNavigablePresets();
+
+    bool isPresetFavourite (const Preset&) const;
+    void setPresetFavourite (const Preset&, bool favourite);
     bool saveCurrentPreset (const juce::String& presetName,
                             const juce::String& presetBank,
                             const juce::String& presetAuthor,
-                            const juce::String& presetComments);
+                            const juce::String& presetComments,
+                            const juce::StringArray& presetTags = juce::StringArray());
+    void saveCurrentPresetAsync (const juce::String& presetName,
+                                 const juce::String& presetBank,
+                                 const juce::String& presetAuthor,
+                                 const juce::String& presetComments,
+                                 const juce::StringArray& presetTags = juce::StringArray(),
+                                 SaveCallback callback = nullptr);
 
     juce::XmlElement* toXml();
     void fromXml (const juce::XmlElement&);
 
+    void writeToStream (juce::OutputStream&) const;
+    bool readFromStream (juce::InputStream&, int formatVersion);
+
+    void writeXml (state::XmlStreamWriter&) const;
+    bool readXml (state::XmlStreamReader&);
+
     void checkPresetChanged();
+    juce::Array<Preset> findPresetsMatchingCurrentState();
+
+    void setNumCompareSlots (int numSlots);
+    inline int getNumCompareSlots() const { return static_cast<int> (mCompareSlots.size()); }
+    inline int getCurrentCompareSlot() const { return mCurrentCompareSlot; }
+    void selectCompareSlot (int slot);
+    void copyCompareSlot (int sourceSlot, int destSlot);
+    bool isCompareSlotModified (int slot) const;
+
+    state::StateDiff getPresetChanges() const;
+    void revertPresetChanges();
+    void applyPresetDiff (const state::StateDiff&);
 
     void addListener (Listener*);
     void removeListener (Listener*);
 
 private:
-    juce::Array<Preset> findPresets (const juce::File&) const;
-    juce::String findPresetBank (const juce::File&, const juce::File&) const;
+    struct CompareSlot
+    {
+        std::vector<float> values;
+        Preset preset;
+        bool isEmpty = true;
+    };
+
+    static constexpr int workerTimeoutMilliseconds = 5000;
+
+private: // PresetCatalogue::Listener
+    void presetCatalogueChanged() override;
+
+private:
     void notifyPresetChanged();
-    void findCurrentPresetIndex();
+    void invalidateCurrentPresetIndex();
+    int getCurrentPresetIndex();
+    Preset createDefaultPreset();
+    void ensureNavigationOrder();
+    Preset createUserPresetSnapshot (const juce::String& presetName,
+                                     const juce::String& presetBank,
+                                     const juce::String& presetAuthor,
+                                     const juce::String& presetComments,
+                                     const juce::StringArray& presetTags);
+    void adoptSavedPreset (const Preset&, juce::uint32 selectionSequence);
+    void adoptLoadedPreset (const Preset&);
     void loadPresetAtIndex (int presetIndex);
+    void storeCompareSlot (int slot);
 
 private:
-    parameters::ParameterManager&   mParameterManager;
-    Preset                          mCurrentPreset;
-    int                             mCurrentPresetIndex;
-    PresetChecker                   mPresetChecker;
-    juce::ListenerList<Listener>    mListeners;
-
+    parameters::ParameterManager&                   mParameterManager;
+    juce::SharedResourcePointer<PresetCatalogue>    mCatalogue;
+    PresetMigrator                                  mMigrator;
+    PresetNavigator                                 mNavigator;
+    bool                                            mNavigatorDirty;
+    Preset                                          mCurrentPreset;
+    juce::uint32                                    mSelectionSequence;
+    int                                             mCurrentPresetIndex;
+    bool                                            mCurrentPresetIndexDirty;
+    std::vector<CompareSlot>                        mCompareSlots;
+    int                                             mCurrentCompareSlot;
+    juce::uint64                                    mLastCheckedPresetHash;
+    juce::uint64                                    mLastCheckedParametersHash;
+    bool                                            mLastCheckedDifferent;
+    PresetChecker                                   mPresetChecker;
+    juce::ListenerList<Listener>                    mListeners;
+    std::atomic<int>                                mNumPendingSaves;
+    juce::WaitableEvent                             mSavesFinished;
+    juce::ThreadPool                                mWorkerPool;
+    PresetLoader                                    mLoader;
+
+    JUCE_DECLARE_WEAK_REFERENCEABLE (PresetManager)
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PresetManager)
 };
 
@@ -0,0 +1,228 @@
+/*
+    GRAPE is Romain's Audio Plug-in Extension classes for the JUCE framework
+
+    Copyright (c) 2018 Romain Clement
+
+    MIT License    
+    
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+    
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+ */
+
+//==============================================================================
+
+#include <grape/presets/PresetMigrator.h>
+#include <grape/presets/EmbeddedPresets.h>
+#include <grape/helpers/RealtimeGuard.h>
+#include <limits>
+
+//==============================================================================
+
+namespace grape {
+namespace presets {
+
+//==============================================================================
+
+constexpr int PresetMigrator::maxCacheSize;
+
+//==============================================================================
+
+PresetMigrator::PresetMigrator (int currentVersion)
+    : mCurrentVersion (juce::jmax (currentVersion, 1))
+    , mCacheClock (0)
+{
+
+}
+
+PresetMigrator::~PresetMigrator()
+{
+
+}
+
+//==============================================================================
+
+void PresetMigrator::setCurrentVersion (int version)
+{
+    mCurrentVersion = juce::jmax (version, 1);
+    clearCache();
+}
+
+void PresetMigrator::addMigration (int fromVersion, Migration migration)
+{
+    jassert (fromVersion > 0 && migration != nullptr);
+
+    mMigrations[fromVersion] = migration;
+    mCurrentVersion = juce::jmax (mCurrentVersion, fromVersion + 1);
+    clearCache();
+}
+
+bool PresetMigrator::canMigrate (int fromVersion) const
+{
+    // Presets from a newer release are never downgraded
+    if (fromVersion > mCurrentVersion)
+        return false;
+
+    for (auto version = fromVersion; version < mCurrentVersion; ++version)
+    {
+        if (mMigrations.find (version) == mMigrations.end())
+            return false;
+    }
+
+    return fromVersion > 0;
+}
+
+bool PresetMigrator::migrate (juce::ValueTree& state, int& version) const
+{
+    if (!canMigrate (version))
+        return false;
+
+    if (version == mCurrentVersion)
+        return true;
+
+    auto migratedState = state.createCopy();
+    for (auto v = version; v < mCurrentVersion; ++v)
+    {
+        if (!mMigrations.at (v) (migratedState))
+            return false;
+    }
+
+    state = migratedState;
+    version = mCurrentVersion;
+    return true;
+}
+
+bool PresetMigrator::loadPreset (Preset& preset)
+{
+    GRAPE_ASSERT_NON_REALTIME ("PresetMigrator::loadPreset");
+
+    const auto file = preset.getFile();
+    const auto key = file.getFullPathName();
+    const auto modificationTime = EmbeddedPresets::indexOf (file) >= 0
+        ? 0 : file.getLastModificationTime().toMilliseconds();
+
+    {
+        GRAPE_SCOPED_LOCK (juce::ScopedLock, mCacheLock);
+        if (mCache.contains (key))
+        {
+            auto& entry = mCache.getReference (key);
+            if (entry.modificationTime == modificationTime)
+            {
+                entry.lastUsed = ++mCacheClock;
+                preset = entry.preset;
+                return true;
+            }
+
+            mCache.remove (key);
+        }
+    }
+
+    if (!preset.loadFromFile())
+        return false;
+
+    if (preset.getVersion() >= mCurrentVersion)
+        return true;
+
+    auto state = preset.copyState();
+    auto version = preset.getVersion();
+    if (!migrate (state, version))
+        return false;
+
+    preset.replaceState (state);
+    preset.setVersion (version);
+
+    GRAPE_SCOPED_LOCK (juce::ScopedLock, mCacheLock);
+
+    // Only the least recently used migration is dropped when the cache is full
+    if (mCache.size() >= maxCacheSize)
+    {
+        juce::String oldestKey;
+        auto oldestUse = std::numeric_limits<juce::uint32>::max();
+
+        for (juce::HashMap<juce::String, CacheEntry>::Iterator it (mCache); it.next();)
+        {
+            if (it.getValue().lastUsed < oldestUse)
+            {
+                oldestKey = it.getKey();
+                oldestUse = it.getValue().lastUsed;
+            }
+        }
+
+        mCache.remove (oldestKey);
+    }
+
+    mCache.set (key, { modificationTime, ++mCacheClock, preset });
+    return true;
+}
+
+int PresetMigrator::upgradeLibrary (const juce::Array<Preset>& presets, int numThreads)
+{
+    if (presets.isEmpty())
+        return 0;
+
+    std::atomic<int> numUpgraded (0);
+    std::atomic<int> numRemaining (presets.size());
+    juce::WaitableEvent finished;
+
+    {
+        juce::ThreadPool pool (numThreads > 0 ? numThreads : juce::SystemStats::getNumCpus());
+
+        for (const auto& p : presets)
+        {
+            pool.addJob ([this, p, &numUpgraded, &numRemaining, &finished]
+            {
+                // Embedded factory presets are read-only
+                auto preset = p;
+                if (EmbeddedPresets::indexOf (preset.getFile()) < 0
+                    && preset.loadFromFile()
+                    && preset.getVersion() < mCurrentVersion)
+                {
+                    auto state = preset.copyState();
+                    auto version = preset.getVersion();
+
+                    if (migrate (state, version))
+                    {
+                        preset.replaceState (state);
+                        preset.setVersion (version);
+
+                        if (preset.saveToFile())
+                            ++numUpgraded;
+                    }
+                }
+
+                if (--numRemaining == 0)
+                    finished.signal();
+            });
+        }
+
+        finished.wait();
+    }
+
+    clearCache();
+    return numUpgraded.load();
+}
+
+void PresetMigrator::clearCache()
+{
+    GRAPE_SCOPED_LOCK (juce::ScopedLock, mCacheLock);
+    mCache.clear();
+}
+
+//==============================================================================
+
+} // namespace presets
+} // namespace grape
@@ -0,0 +1,86 @@
+/*
+    GRAPE is Romain's Audio Plug-in Extension classes for the JUCE framework
+
+    Copyright (c) 2018 Romain Clement
+
+    MIT License    
+    
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+    
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+ */
+
+//==============================================================================
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <grape/presets/Preset.h>
+#include <map>
+
+//==============================================================================
+
+namespace grape {
+namespace presets {
+
+//==============================================================================
+
+class PresetMigrator
+{
+public:
+    using Migration = std::function<bool (juce::ValueTree&)>;
+
+public:
+    PresetMigrator (int currentVersion = 1);
+    ~PresetMigrator();
+
+public:
+    inline int getCurrentVersion() const { return mCurrentVersion; }
+    void setCurrentVersion (int version);
+
+    void addMigration (int fromVersion, Migration migration);
+    bool canMigrate (int fromVersion) const;
+    bool migrate (juce::ValueTree& state, int& version) const;
+
+    bool loadPreset (Preset& preset);
+    int upgradeLibrary (const juce::Array<Preset>& presets, int numThreads = 0);
+    void clearCache();
+
+private:
+    struct CacheEntry
+    {
+        juce::int64     modificationTime = 0;
+        juce::uint32    lastUsed = 0;
+        Preset          preset;
+    };
+
+    static constexpr int maxCacheSize = 64;
+
+private:
+    int                                 mCurrentVersion;
+    std::map<int, Migration>            mMigrations;
+    juce::HashMap<juce::String, CacheEntry> mCache;
+    juce::uint32                        mCacheClock;
+    juce::CriticalSection               mCacheLock;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PresetMigrator)
+};
+
+//==============================================================================
+
+} // namespace presets
+} // namespace grape
@@ -0,0 +1,229 @@
+/*
+    GRAPE is Romain's Audio Plug-in Extension classes for the JUCE framework
+
+    Copyright (c) 2018 Romain Clement
+
+    MIT License    
+    
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+    
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+ */
+
+//==============================================================================
+
+#include <grape/presets/PresetMorpher.h>
+#include <grape/helpers/RealtimeGuard.h>
+
+//==============================================================================
+
+namespace grape {
+namespace presets {
+
+//==============================================================================
+
+constexpr int PresetMorpher::hostSyncIntervalMilliseconds;
+
+//==============================================================================
+
+PresetMorpher::PresetMorpher (parameters::ParameterManager& parameterManager, PresetMigrator& migrator)
+    : mParameterManager (parameterManager)
+    , mMigrator (migrator)
+    , mNumParameters (parameterManager.getNumParameters())
+    , mValues (static_cast<size_t> (mNumParameters), true)
+    , mNumPresets (0)
+    , mPositionX (0.0f)
+    , mPositionY (0.0f)
+    , mTwoDimensional (false)
+    , mMorphChanged (false)
+    , mValuesApplied (false)
+{
+    for (int i = 0; i < mNumParameters; ++i)
+    {
+        const auto& info = mParameterManager.getParameterInfo (i);
+        if (info.isDiscrete || info.isBoolean)
+        {
+            mDiscreteIndexes.add (i);
+        }
+    }
+
+    startTimer (hostSyncIntervalMilliseconds);
+}
+
+PresetMorpher::~PresetMorpher()
+{
+    stopTimer();
+}
+
+//==============================================================================
+
+void PresetMorpher::setPresets (const juce::Array<Preset>& presets)
+{
+    const auto numPresets = presets.size();
+    juce::HeapBlock<float> matrix (static_cast<size_t> (numPresets * mNumParameters));
+    juce::HeapBlock<float> weights (static_cast<size_t> (numPresets), true);
+
+    for (int p = 0; p < numPresets; ++p)
+    {
+        // Presets go through the same migrations as regular loads
+        auto preset = presets[p];
+        if (!preset.getState().isValid())
+        {
+            mMigrator.loadPreset (preset);
+        }
+        else if (preset.getVersion() < mMigrator.getCurrentVersion())
+        {
+            auto state = preset.copyState();
+            auto version = preset.getVersion();
+            if (mMigrator.migrate (state, version))
+                preset.replaceState (state);
+        }
+
+        auto row = matrix.get() + p * mNumParameters;
+        for (int i = 0; i < mNumParameters; ++i)
+        {
+            row[i] = mParameterManager.getParameterByIndex (i)->getDefaultValue();
+        }
+
+        const auto& state = preset.getState();
+        for (int c = 0; c < state.getNumChildren(); ++c)
+        {
+            const auto child = state.getChild (c);
+            const auto index = mParameterManager.indexOfParameter (child.getProperty ("id").toString());
+
+            if (index >= 0)
+            {
+                const auto& range = mParameterManager.getParameterInfo (index).valueRange;
+                const auto value = static_cast<float> (static_cast<double> (child.getProperty ("value")));
+                row[index] = range.convertTo0to1 (value);
+            }
+        }
+    }
+
+    GRAPE_SCOPED_LOCK (juce::SpinLock::ScopedLockType, mLock);
+    mMatrix.swapWith (matrix);
+    mWeights.swapWith (weights);
+    mNumPresets = numPresets;
+    mMorphChanged = true;
+}
+
+int PresetMorpher::getNumPresets() const
+{
+    return mNumPresets;
+}
+
+void PresetMorpher::setPosition (float x)
+{
+    mPositionX = juce::jlimit (0.0f, 1.0f, x);
+    mTwoDimensional = false;
+    mMorphChanged = true;
+}
+
+void PresetMorpher::setPosition (float x, float y)
+{
+    mPositionX = juce::jlimit (0.0f, 1.0f, x);
+    mPositionY = juce::jlimit (0.0f, 1.0f, y);
+    mTwoDimensional = true;
+    mMorphChanged = true;
+}
+
+void PresetMorpher::process()
+{
+    // Parameters stay where the user or the host put them until the position
+    // or the presets change again
+    if (!mMorphChanged.load())
+        return;
+
+    const juce::SpinLock::ScopedTryLockType lock (mLock);
+    if (!lock.isLocked() || mNumPresets == 0 || mNumParameters == 0)
+        return;
+
+    mMorphChanged = false;
+
+    computeWeights (mNumPresets);
+
+    juce::FloatVectorOperations::clear (mValues.get(), mNumParameters);
+
+    auto dominantPreset = 0;
+    for (int p = 0; p < mNumPresets; ++p)
+    {
+        const auto weight = mWeights[static_cast<size_t> (p)];
+        if (weight <= 0.0f)
+            continue;
+
+        juce::FloatVectorOperations::addWithMultiply (
+            mValues.get(), mMatrix.get() + p * mNumParameters, weight, mNumParameters
+        );
+
+        if (weight > mWeights[static_cast<size_t> (dominantPreset)])
+            dominantPreset = p;
+    }
+
+    const auto dominantRow = mMatrix.get() + dominantPreset * mNumParameters;
+    for (auto i : mDiscreteIndexes)
+    {
+        mValues[static_cast<size_t> (i)] = dominantRow[i];
+    }
+
+    // Compared against the live values, which automation or a preset load
+    // may have moved since the last block
+    mParameterManager.applyValues (mValues.get(), false);
+    mValuesApplied = true;
+}
+
+//==============================================================================
+
+void PresetMorpher::timerCallback()
+{
+    if (mValuesApplied.exchange (false))
+        mParameterManager.notifyChangedValues();
+}
+
+//==============================================================================
+
+void PresetMorpher::computeWeights (int numPresets)
+{
+    juce::FloatVectorOperations::clear (mWeights.get(), numPresets);
+
+    const auto x = mPositionX.load();
+    const auto y = mPositionY.load();
+
+    // Bilinear over the four corner presets; see setPosition (x, y)
+    if (mTwoDimensional && numPresets >= 4)
+    {
+        mWeights[0] = (1.0f - x) * (1.0f - y);
+        mWeights[1] = x * (1.0f - y);
+        mWeights[2] = (1.0f - x) * y;
+        mWeights[3] = x * y;
+        return;
+    }
+
+    const auto position = x * static_cast<float> (numPresets - 1);
+    const auto index = juce::jmin (static_cast<int> (position), numPresets - 1);
+    const auto fraction = position - static_cast<float> (index);
+
+    mWeights[static_cast<size_t> (index)] = 1.0f - fraction;
+    if (index + 1 < numPresets)
+    {
+        mWeights[static_cast<size_t> (index + 1)] = fraction;
+    }
+}
+
+//==============================================================================
+
+} // namespace presets
+} // namespace grape
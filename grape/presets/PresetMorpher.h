@@ -0,0 +1,97 @@
+/*
+    GRAPE is Romain's Audio Plug-in Extension classes for the JUCE framework
+
+    Copyright (c) 2018 Romain Clement
+
+    MIT License    
+    
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+    
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+ */
+
+//==============================================================================
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <grape/presets/Preset.h>
+#include <grape/presets/PresetMigrator.h>
+#include <grape/parameters/ParameterManager.h>
+#include <atomic>
+
+//==============================================================================
+
+namespace grape {
+namespace presets {
+
+//==============================================================================
+
+class PresetMorpher : private juce::Timer
+{
+public:
+    PresetMorpher (parameters::ParameterManager&, PresetMigrator&);
+    ~PresetMorpher();
+
+public:
+    void setPresets (const juce::Array<Preset>&);
+    int getNumPresets() const;
+
+    // Morphs along the list of presets
+    void setPosition (float x);
+
+    // Morphs between the first four presets, placed at the corners (0, 0),
+    // (1, 0), (0, 1) and (1, 1). Further presets are ignored, and with fewer
+    // than four only x is used.
+    void setPosition (float x, float y);
+
+    // Called from the audio thread. Hosts and listeners are notified from
+    // the message thread shortly after.
+    void process();
+
+private: // juce::Timer
+    void timerCallback() override;
+
+private:
+    static constexpr int hostSyncIntervalMilliseconds = 50;
+
+private:
+    void computeWeights (int numPresets);
+
+private:
+    parameters::ParameterManager&   mParameterManager;
+    PresetMigrator&                 mMigrator;
+    const int                       mNumParameters;
+    juce::SpinLock                  mLock;
+    juce::HeapBlock<float>          mMatrix;
+    juce::HeapBlock<float>          mWeights;
+    juce::HeapBlock<float>          mValues;
+    juce::Array<int>                mDiscreteIndexes;
+    int                             mNumPresets;
+    std::atomic<float>              mPositionX;
+    std::atomic<float>              mPositionY;
+    std::atomic<bool>               mTwoDimensional;
+    std::atomic<bool>               mMorphChanged;
+    std::atomic<bool>               mValuesApplied;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PresetMorpher)
+};
+
+//==============================================================================
+
+} // namespace presets
+} // namespace grape
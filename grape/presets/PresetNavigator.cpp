@@ -0,0 +1,224 @@
+/*
+    GRAPE is Romain's Audio Plug-in Extension classes for the JUCE framework
+
+    Copyright (c) 2018 Romain Clement
+
+    MIT License    
+    
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+    
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+ */
+
+//==============================================================================
+
+#include <grape/presets/PresetNavigator.h>
+#include <grape/presets/PresetCatalogue.h>
+#include <algorithm>
+
+//==============================================================================
+
+namespace grape {
+namespace presets {
+
+//==============================================================================
+
+namespace {
+
+struct Entry
+{
+    int             index;
+    bool            isUser;
+    bool            isFavourite;
+    juce::String    bankKey;
+    juce::String    nameKey;
+    juce::int64     date;
+    juce::String    path;
+};
+
+} // namespace
+
+//==============================================================================
+
+PresetNavigator::PresetNavigator()
+    : mSortKeys ({ sortByBank, sortByName })
+    , mFavouritesFirst (false)
+{
+
+}
+
+PresetNavigator::~PresetNavigator()
+{
+
+}
+
+//==============================================================================
+
+void PresetNavigator::setSortOrder (const juce::Array<SortKey>& sortKeys, bool favouritesFirst)
+{
+    mSortKeys = sortKeys;
+    mFavouritesFirst = favouritesFirst;
+}
+
+void PresetNavigator::rebuild (PresetCatalogue& catalogue)
+{
+    mOrder = catalogue.getNavigationOrder (mSortKeys, mFavouritesFirst);
+}
+
+bool PresetNavigator::isUpToDate (const PresetCatalogue& catalogue) const
+{
+    return mOrder != nullptr && mOrder->generation == catalogue.getGeneration();
+}
+
+int PresetNavigator::getCatalogueIndex (int position) const
+{
+    if (mOrder == nullptr || !juce::isPositiveAndBelow (position, static_cast<int> (mOrder->indexes.size())))
+        return -1;
+
+    return mOrder->indexes[static_cast<size_t> (position)];
+}
+
+int PresetNavigator::getPosition (int catalogueIndex) const
+{
+    if (mOrder == nullptr || !juce::isPositiveAndBelow (catalogueIndex, static_cast<int> (mOrder->positions.size())))
+        return -1;
+
+    return mOrder->positions[static_cast<size_t> (catalogueIndex)];
+}
+
+std::shared_ptr<const PresetNavigator::Order> PresetNavigator::createOrder (const juce::Array<Preset>& presets,
+                                                                           int numFactoryPresets,
+                                                                           const juce::StringArray& favouriteFiles,
+                                                                           const std::vector<juce::int64>& modificationTimes,
+                                                                           const juce::Array<SortKey>& sortKeys,
+                                                                           bool favouritesFirst,
+                                                                           juce::uint32 generation)
+{
+    jassert (modificationTimes.size() == static_cast<size_t> (presets.size()));
+
+    std::vector<Entry> entries;
+    entries.reserve (static_cast<size_t> (presets.size()));
+
+    for (int i = 0; i < presets.size(); ++i)
+    {
+        const auto& p = presets.getReference (i);
+        const auto path = p.getFile().getFullPathName();
+
+        entries.push_back ({
+            i,
+            i >= numFactoryPresets,
+            favouriteFiles.contains (path),
+            makeCollationKey (p.getBank()),
+            makeCollationKey (p.getName()),
+            modificationTimes[static_cast<size_t> (i)],
+            path
+        });
+    }
+
+    std::sort (entries.begin(), entries.end(), [&sortKeys, favouritesFirst] (const Entry& a, const Entry& b)
+    {
+        if (a.isUser != b.isUser)
+            return b.isUser;
+
+        if (favouritesFirst && a.isFavourite != b.isFavourite)
+            return a.isFavourite;
+
+        for (auto key : sortKeys)
+        {
+            switch (key)
+            {
+                case sortByBank:
+                {
+                    const auto result = a.bankKey.compare (b.bankKey);
+                    if (result != 0)
+                        return result < 0;
+                    break;
+                }
+
+                case sortByName:
+                {
+                    const auto result = a.nameKey.compare (b.nameKey);
+                    if (result != 0)
+                        return result < 0;
+                    break;
+                }
+
+                case sortByDate:
+                {
+                    if (a.date != b.date)
+                        return a.date > b.date;
+                    break;
+                }
+            }
+        }
+
+        return a.path.compare (b.path) < 0;
+    });
+
+    auto order = std::make_shared<Order>();
+    order->generation = generation;
+    order->indexes.reserve (entries.size());
+    order->positions.assign (entries.size(), -1);
+
+    for (const auto& entry : entries)
+    {
+        order->positions[static_cast<size_t> (entry.index)] = static_cast<int> (order->indexes.size());
+        order->indexes.push_back (entry.index);
+    }
+
+    return order;
+}
+
+juce::String PresetNavigator::makeCollationKey (const juce::String& text)
+{
+    static constexpr int numberWidth = 10;
+
+    juce::String key;
+    key.preallocateBytes (text.getNumBytesAsUTF8() + numberWidth);
+
+    juce::String digits;
+    auto p = text.getCharPointer();
+
+    for (;;)
+    {
+        const auto c = p.getAndAdvance();
+
+        if (juce::CharacterFunctions::isDigit (c))
+        {
+            digits += c;
+            continue;
+        }
+
+        if (digits.isNotEmpty())
+        {
+            key += digits.paddedLeft ('0', numberWidth);
+            digits.clear();
+        }
+
+        if (c == 0)
+            break;
+
+        key += juce::CharacterFunctions::toLowerCase (c);
+    }
+
+    return key;
+}
+
+//==============================================================================
+
+} // namespace presets
+} // namespace grape
@@ -0,0 +1,101 @@
+/*
+    GRAPE is Romain's Audio Plug-in Extension classes for the JUCE framework
+
+    Copyright (c) 2018 Romain Clement
+
+    MIT License    
+    
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+    
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+ */
+
+//==============================================================================
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <grape/presets/Preset.h>
+#include <memory>
+#include <vector>
+
+//==============================================================================
+
+namespace grape {
+namespace presets {
+
+//==============================================================================
+
+class PresetCatalogue;
+
+class PresetNavigator
+{
+public:
+    enum SortKey
+    {
+        sortByBank,
+        sortByName,
+        sortByDate
+    };
+
+    /** A navigation order of the catalogue. Orders are immutable and shared by
+        every PresetNavigator using the same sort settings.
+    */
+    struct Order
+    {
+        std::vector<int> indexes;       // navigation position -> catalogue index
+        std::vector<int> positions;     // catalogue index -> navigation position
+        juce::uint32     generation;    // catalogue generation it was built from
+    };
+
+public:
+    PresetNavigator();
+    ~PresetNavigator();
+
+public:
+    void setSortOrder (const juce::Array<SortKey>& sortKeys, bool favouritesFirst);
+    inline const juce::Array<SortKey>& getSortKeys() const { return mSortKeys; }
+    inline bool isFavouritesFirst() const { return mFavouritesFirst; }
+
+    void rebuild (PresetCatalogue&);
+    bool isUpToDate (const PresetCatalogue&) const;
+
+    inline int getNumPresets() const { return mOrder != nullptr ? static_cast<int> (mOrder->indexes.size()) : 0; }
+    int getCatalogueIndex (int position) const;
+    int getPosition (int catalogueIndex) const;
+
+    static std::shared_ptr<const Order> createOrder (const juce::Array<Preset>& presets,
+                                                     int numFactoryPresets,
+                                                     const juce::StringArray& favouriteFiles,
+                                                     const std::vector<juce::int64>& modificationTimes,
+                                                     const juce::Array<SortKey>& sortKeys,
+                                                     bool favouritesFirst,
+                                                     juce::uint32 generation);
+    static juce::String makeCollationKey (const juce::String& text);
+
+private:
+    juce::Array<SortKey>            mSortKeys;
+    bool                            mFavouritesFirst;
+    std::shared_ptr<const Order>    mOrder;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PresetNavigator)
+};
+
+//==============================================================================
+
+} // namespace presets
+} // namespace grape
@@ -0,0 +1,141 @@
+/*
+    GRAPE is Romain's Audio Plug-in Extension classes for the JUCE framework
+
+    Copyright (c) 2018 Romain Clement
+
+    MIT License    
+    
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+    
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+ */
+
+//==============================================================================
+
+#include <grape/presets/PresetTagIndex.h>
+
+//==============================================================================
+
+namespace grape {
+namespace presets {
+
+//==============================================================================
+
+PresetTagIndex::PresetTagIndex()
+{
+
+}
+
+PresetTagIndex::~PresetTagIndex()
+{
+
+}
+
+//==============================================================================
+
+void PresetTagIndex::clear()
+{
+    mTagBitmaps.clear();
+    mPresetTags.clear();
+    mAllPresets.clear();
+}
+
+void PresetTagIndex::setPresetTags (int presetIndex, const juce::StringArray& tags)
+{
+    const auto previous = mPresetTags.find (presetIndex);
+    if (previous != mPresetTags.end())
+    {
+        for (const auto& tag : previous->second)
+        {
+            auto bitmap = mTagBitmaps.find (tag);
+            if (bitmap != mTagBitmaps.end())
+            {
+                bitmap->second.remove (presetIndex);
+                if (bitmap->second.isEmpty())
+                    mTagBitmaps.erase (bitmap);
+            }
+        }
+    }
+
+    juce::StringArray normalisedTags;
+    for (const auto& tag : tags)
+    {
+        const auto normalised = normaliseTag (tag);
+        if (normalised.isNotEmpty())
+            normalisedTags.addIfNotAlreadyThere (normalised);
+    }
+
+    for (const auto& tag : normalisedTags)
+        mTagBitmaps[tag].add (presetIndex);
+
+    mPresetTags[presetIndex] = normalisedTags;
+    mAllPresets.add (presetIndex);
+}
+
+juce::StringArray PresetTagIndex::getAllTags() const
+{
+    juce::StringArray tags;
+    for (const auto& entry : mTagBitmaps)
+        tags.add (entry.first);
+
+    return tags;
+}
+
+int PresetTagIndex::countPresetsWithTag (const juce::String& tag) const
+{
+    return getPresetsWithTag (tag).count();
+}
+
+PresetBitmap PresetTagIndex::getPresetsWithTag (const juce::String& tag) const
+{
+    const auto it = mTagBitmaps.find (normaliseTag (tag));
+    return it != mTagBitmaps.end() ? it->second : PresetBitmap();
+}
+
+PresetBitmap PresetTagIndex::query (const juce::StringArray& allOf,
+                                    const juce::StringArray& anyOf,
+                                    const juce::StringArray& noneOf) const
+{
+    auto result = mAllPresets;
+
+    for (const auto& tag : allOf)
+        result = result & getPresetsWithTag (tag);
+
+    if (!anyOf.isEmpty())
+    {
+        PresetBitmap any;
+        for (const auto& tag : anyOf)
+            any = any | getPresetsWithTag (tag);
+
+        result = result & any;
+    }
+
+    for (const auto& tag : noneOf)
+        result = result.andNot (getPresetsWithTag (tag));
+
+    return result;
+}
+
+juce::String PresetTagIndex::normaliseTag (const juce::String& tag)
+{
+    return tag.trim().toLowerCase().removeCharacters (",");
+}
+
+//==============================================================================
+
+} // namespace presets
+} // namespace grape
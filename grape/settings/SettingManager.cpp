@@ -27,6 +27,8 @@
 //==============================================================================
 
 #include <grape/settings/SettingManager.h>
+#include <grape/helpers/Profiler.h>
+#include <grape/helpers/RealtimeGuard.h>
 
 //==============================================================================
 
@@ -64,28 +66,175 @@ SettingManager::~SettingManager()
 
 juce::var SettingManager::getSetting (const juce::String& identifier)
 {
+    GRAPE_ASSERT_NON_REALTIME ("SettingManager::getSetting");
+
     return mSettings.getProperty (juce::Identifier (identifier));
 }
 
 void SettingManager::setSetting (const juce::String& identifier, const juce::var& value)
 {
+    GRAPE_ASSERT_NON_REALTIME ("SettingManager::setSetting");
+
     mSettings.setProperty (juce::Identifier (identifier), value, mUndoManager);
 }
 
+juce::ValueTree SettingManager::copyState() const
+{
+    GRAPE_ASSERT_NON_REALTIME ("SettingManager::copyState");
+    GRAPE_PROFILE_SCOPE ("SettingManager::copyState");
+
+    return mSettings.createCopy();
+}
+
+void SettingManager::applyDiff (const state::StateDiff& diff)
+{
+    for (const auto& change : diff)
+    {
+        if (!change.isParameter && !change.newValue.isVoid())
+        {
+            setSetting (change.id, change.newValue);
+        }
+    }
+}
+
 juce::XmlElement* SettingManager::toXml()
 {
+    GRAPE_ASSERT_NON_REALTIME ("SettingManager::toXml");
+    GRAPE_PROFILE_SCOPE ("SettingManager::toXml");
+
     const auto stateSettings = mSettings.createCopy();
     return stateSettings.createXml();
 }
 
 void SettingManager::fromXml (const juce::XmlElement& xmlState)
 {
+    GRAPE_ASSERT_NON_REALTIME ("SettingManager::fromXml");
+    GRAPE_PROFILE_SCOPE ("SettingManager::fromXml");
+
     if (xmlState.hasTagName (mSettings.getType()))
     {
         mSettings = juce::ValueTree::fromXml (xmlState);
     }
 }
 
+void SettingManager::writeToStream (juce::OutputStream& output) const
+{
+    const auto numSettings = mSettings.getNumProperties();
+    output.writeCompressedInt (numSettings);
+
+    for (int i = 0; i < numSettings; ++i)
+    {
+        const auto name = mSettings.getPropertyName (i);
+        output.writeString (name.toString());
+        mSettings.getProperty (name).writeToStream (output);
+    }
+}
+
+bool SettingManager::readFromStream (juce::InputStream& input)
+{
+    const auto numSettings = input.readCompressedInt();
+    if (numSettings < 0)
+        return false;
+
+    for (int i = 0; i < numSettings; ++i)
+    {
+        if (input.isExhausted())
+            return false;
+
+        const auto id = input.readString();
+        const auto value = juce::var::readFromStream (input);
+
+        if (id.isNotEmpty())
+        {
+            mSettings.setProperty (juce::Identifier (id), value, nullptr);
+        }
+    }
+
+    return true;
+}
+
+void SettingManager::writeXml (state::XmlStreamWriter& writer) const
+{
+    GRAPE_ASSERT_NON_REALTIME ("SettingManager::writeXml");
+    GRAPE_PROFILE_SCOPE ("SettingManager::writeXml");
+
+    const auto& tagName = mSettings.getType().toString();
+    writer.startElement (tagName);
+
+    for (int i = 0; i < mSettings.getNumProperties(); ++i)
+    {
+        const auto name = mSettings.getPropertyName (i);
+        writer.writeVarAttribute (name.toString(), mSettings.getProperty (name));
+    }
+
+    writer.endElement (tagName);
+}
+
+bool SettingManager::readXml (state::XmlStreamReader& reader)
+{
+    GRAPE_ASSERT_NON_REALTIME ("SettingManager::readXml");
+    GRAPE_PROFILE_SCOPE ("SettingManager::readXml");
+
+    if (!reader.hasTagName (mSettings.getType().toString()))
+        return false;
+
+    for (int i = 0; i < mSettings.getNumProperties(); ++i)
+    {
+        const auto name = mSettings.getPropertyName (i);
+        const auto index = reader.findAttribute (name.toString());
+
+        if (index < 0)
+            continue;
+
+        const auto& current = mSettings.getProperty (name);
+
+        if (current.isInt())
+            mSettings.setProperty (name, reader.getIntAttribute (name.toString()), nullptr);
+        else if (current.isBool())
+            mSettings.setProperty (name, reader.getBoolAttribute (name.toString()), nullptr);
+        else if (current.isDouble())
+            mSettings.setProperty (name, reader.getDoubleAttribute (name.toString()), nullptr);
+        else if (!current.isString() || !reader.attributeValueMatches (index, current.toString()))
+            mSettings.setProperty (name, reader.getAttributeValue (index), nullptr);
+    }
+
+    return reader.skipElement();
+}
+
+void SettingManager::checkpoint()
+{
+    mChangedSettings.clearQuick();
+}
+
+bool SettingManager::hasChangesSinceCheckpoint() const
+{
+    return !mChangedSettings.isEmpty();
+}
+
+void SettingManager::writeChangesToStream (juce::OutputStream& output)
+{
+    output.writeCompressedInt (mChangedSettings.size());
+
+    for (const auto& name : mChangedSettings)
+    {
+        output.writeString (name.toString());
+        mSettings.getProperty (name).writeToStream (output);
+    }
+
+    mWrittenSettings.swapWith (mChangedSettings);
+    mChangedSettings.clearQuick();
+}
+
+void SettingManager::restoreWrittenChanges()
+{
+    for (const auto& name : mWrittenSettings)
+    {
+        mChangedSettings.addIfNotAlreadyThere (name);
+    }
+
+    mWrittenSettings.clearQuick();
+}
+
 void SettingManager::addListener (Listener* listener)
 {
     mListeners.add (listener);
@@ -111,6 +260,7 @@ void SettingManager::valueTreePropertyChanged (juce::ValueTree& tree, const juce
 {
     const auto id = identifier.toString();
     const auto value = mSettings.getProperty (identifier);
+    mChangedSettings.addIfNotAlreadyThere (identifier);
     notifySettingChanged (id, value);
 }
 
@@ -140,6 +290,7 @@ void SettingManager::valueTreeRedirected (juce::ValueTree& tree)
     {
         const auto name = tree.getPropertyName (i);
         const auto prop = tree.getProperty (juce::Identifier (name));
+        mChangedSettings.addIfNotAlreadyThere (name);
         notifySettingChanged (name.toString(), prop);
     }
 }
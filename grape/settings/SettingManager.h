@@ -30,6 +30,9 @@
 
 #include <JuceHeader.h>
 #include <grape/settings/Setting.h>
+#include <grape/state/StateDiff.h>
+#include <grape/state/XmlStreamReader.h>
+#include <grape/state/XmlStreamWriter.h>
 #include <vector>
 
 //==============================================================================
@@ -61,9 +64,23 @@ public:
     juce::var getSetting (const juce::String&);
     void setSetting (const juce::String&, const juce::var&);
 
+    juce::ValueTree copyState() const;
+    void applyDiff (const state::StateDiff&);
+
     juce::XmlElement* toXml();
     void fromXml (const juce::XmlElement&);
 
+    void writeToStream (juce::OutputStream&) const;
+    bool readFromStream (juce::InputStream&);
+
+    void writeXml (state::XmlStreamWriter&) const;
+    bool readXml (state::XmlStreamReader&);
+
+    void checkpoint();
+    bool hasChangesSinceCheckpoint() const;
+    void writeChangesToStream (juce::OutputStream&);
+    void restoreWrittenChanges();
+
     void addListener (Listener*);
     void removeListener (Listener*);
 
@@ -82,6 +99,8 @@ private:
     const std::vector<Setting>      mSettingsInfo;
     juce::UndoManager*              mUndoManager;
     juce::ValueTree                 mSettings;
+    juce::Array<juce::Identifier>   mChangedSettings;
+    juce::Array<juce::Identifier>   mWrittenSettings;
     juce::ListenerList<Listener>    mListeners;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SettingManager)
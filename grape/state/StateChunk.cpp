@@ -0,0 +1,248 @@
+/*
+    GRAPE is Romain's Audio Plug-in Extension classes for the JUCE framework
+
+    Copyright (c) 2018 Romain Clement
+
+    MIT License    
+    
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+    
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+ */
+
+//==============================================================================
+
+#include <grape/state/StateChunk.h>
+#include <grape/helpers/Profiler.h>
+
+//==============================================================================
+
+namespace grape {
+namespace state {
+
+//==============================================================================
+
+static const int sChunkMagic = 0x45505247; // 'GRPE'
+
+// Upper bounds for the payload size declared in a chunk header, checked before
+// anything is allocated. Deflate cannot expand data by more than ~1032:1.
+static const juce::int64 sMaxPayloadSize = 256 * 1024 * 1024;
+static const juce::int64 sMaxCompressionRatio = 1032;
+
+template <class Manager>
+static void writeSection (juce::MemoryOutputStream& output, int tag, const Manager& manager)
+{
+    output.writeInt (tag);
+
+    const auto sizePosition = output.getPosition();
+    output.writeInt (0);
+
+    manager.writeToStream (output);
+
+    const auto endPosition = output.getPosition();
+    output.setPosition (sizePosition);
+    output.writeInt (static_cast<int> (endPosition - sizePosition - 4));
+    output.setPosition (endPosition);
+}
+
+//==============================================================================
+
+StateChunk::StateChunk (parameters::ParameterManager* parameterManager,
+                        settings::SettingManager* settingManager,
+                        presets::PresetManager* presetManager)
+    : mParameterManager (parameterManager)
+    , mSettingManager (settingManager)
+    , mPresetManager (presetManager)
+    , mCompressionEnabled (false)
+{
+
+}
+
+StateChunk::~StateChunk()
+{
+
+}
+
+//==============================================================================
+
+void StateChunk::save (juce::MemoryBlock& destData)
+{
+    GRAPE_PROFILE_SCOPE ("StateChunk::save");
+
+    juce::MemoryOutputStream payload (mScratch, false);
+    writeSections (payload);
+
+    const auto payloadSize = payload.getDataSize();
+
+    juce::MemoryOutputStream output (destData, false);
+    output.writeInt (sChunkMagic);
+    output.writeInt (formatVersion);
+    output.writeInt (mCompressionEnabled ? compressed : 0);
+    output.writeInt64 (static_cast<juce::int64> (payloadSize));
+
+    if (mCompressionEnabled)
+    {
+        juce::GZIPCompressorOutputStream compressor (output);
+        compressor.write (payload.getData(), payloadSize);
+    }
+    else
+    {
+        output.write (payload.getData(), payloadSize);
+    }
+}
+
+bool StateChunk::load (const void* data, int sizeInBytes)
+{
+    GRAPE_PROFILE_SCOPE ("StateChunk::load");
+
+    if (data == nullptr || sizeInBytes <= 0)
+        return false;
+
+    juce::MemoryInputStream input (data, static_cast<size_t> (sizeInBytes), false);
+
+    if (input.readInt() != sChunkMagic)
+        return loadLegacyXml (data, sizeInBytes);
+
+    const auto version      = input.readInt();
+    const auto flags        = input.readInt();
+    const auto payloadSize  = input.readInt64();
+
+    if (version <= 0 || version > formatVersion || input.isExhausted())
+        return false;
+
+    if (payloadSize < 0 || payloadSize > sMaxPayloadSize)
+        return false;
+
+    const auto headerSize = static_cast<size_t> (input.getPosition());
+    const auto payloadData = static_cast<const char*> (data) + headerSize;
+    const auto remainingSize = static_cast<size_t> (sizeInBytes) - headerSize;
+
+    if ((flags & compressed) != 0)
+    {
+        if (payloadSize > static_cast<juce::int64> (remainingSize) * sMaxCompressionRatio)
+            return false;
+
+        juce::MemoryInputStream compressedInput (payloadData, remainingSize, false);
+        juce::GZIPDecompressorInputStream decompressor (compressedInput);
+
+        mScratch.setSize (static_cast<size_t> (payloadSize), false);
+        const auto numRead = decompressor.read (mScratch.getData(), static_cast<int> (payloadSize));
+
+        if (numRead != static_cast<int> (payloadSize))
+            return false;
+
+        return readSections (mScratch.getData(), static_cast<size_t> (payloadSize), version);
+    }
+
+    if (static_cast<size_t> (payloadSize) > remainingSize)
+        return false;
+
+    return readSections (payloadData, static_cast<size_t> (payloadSize), version);
+}
+
+//==============================================================================
+
+void StateChunk::writeSections (juce::MemoryOutputStream& output)
+{
+    if (mParameterManager != nullptr)
+        writeSection (output, parametersSection, *mParameterManager);
+
+    if (mSettingManager != nullptr)
+        writeSection (output, settingsSection, *mSettingManager);
+
+    if (mPresetManager != nullptr)
+        writeSection (output, presetsSection, *mPresetManager);
+}
+
+bool StateChunk::readSections (const void* data, size_t sizeInBytes, int version)
+{
+    juce::MemoryInputStream input (data, sizeInBytes, false);
+
+    while (input.getNumBytesRemaining() >= 8)
+    {
+        const auto tag = input.readInt();
+        const auto sectionSize = input.readInt();
+        const auto sectionPosition = static_cast<size_t> (input.getPosition());
+
+        if (sectionSize < 0 || static_cast<size_t> (sectionSize) > sizeInBytes - sectionPosition)
+            return false;
+
+        const auto sectionData = static_cast<const char*> (data) + sectionPosition;
+        if (!readSection (tag, sectionData, static_cast<size_t> (sectionSize), version))
+            return false;
+
+        input.skipNextBytes (sectionSize);
+    }
+
+    return true;
+}
+
+bool StateChunk::readSection (int tag, const void* data, size_t sizeInBytes, int version)
+{
+    juce::MemoryInputStream input (data, sizeInBytes, false);
+
+    switch (tag)
+    {
+        case parametersSection:
+            return mParameterManager == nullptr || mParameterManager->readFromStream (input);
+
+        case settingsSection:
+            return mSettingManager == nullptr || mSettingManager->readFromStream (input);
+
+        case presetsSection:
+            return mPresetManager == nullptr || mPresetManager->readFromStream (input, version);
+
+        default:
+            return true;
+    }
+}
+
+bool StateChunk::loadLegacyXml (const void* data, int sizeInBytes)
+{
+    std::unique_ptr<juce::XmlElement> xmlState (
+        juce::AudioProcessor::getXmlFromBinary (data, sizeInBytes)
+    );
+
+    if (xmlState.get() == nullptr)
+        return false;
+
+    loadLegacyXmlElement (*xmlState);
+
+    for (auto child = xmlState->getFirstChildElement(); child != nullptr; child = child->getNextElement())
+    {
+        loadLegacyXmlElement (*child);
+    }
+
+    return true;
+}
+
+void StateChunk::loadLegacyXmlElement (const juce::XmlElement& xmlState)
+{
+    if (mParameterManager != nullptr)
+        mParameterManager->fromXml (xmlState);
+
+    if (mSettingManager != nullptr)
+        mSettingManager->fromXml (xmlState);
+
+    if (mPresetManager != nullptr)
+        mPresetManager->fromXml (xmlState);
+}
+
+//==============================================================================
+
+} // namespace state
+} // namespace grape
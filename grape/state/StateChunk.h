@@ -0,0 +1,93 @@
+/*
+    GRAPE is Romain's Audio Plug-in Extension classes for the JUCE framework
+
+    Copyright (c) 2018 Romain Clement
+
+    MIT License    
+    
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+    
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+ */
+
+//==============================================================================
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <grape/parameters/ParameterManager.h>
+#include <grape/settings/SettingManager.h>
+#include <grape/presets/PresetManager.h>
+
+//==============================================================================
+
+namespace grape {
+namespace state {
+
+//==============================================================================
+
+class StateChunk
+{
+public:
+    StateChunk (parameters::ParameterManager*,
+                settings::SettingManager* = nullptr,
+                presets::PresetManager* = nullptr);
+    ~StateChunk();
+
+public:
+    // 2: presets carry their tags
+    static constexpr int formatVersion = 2;
+
+    inline bool isCompressionEnabled() const { return mCompressionEnabled; }
+    inline void setCompressionEnabled (bool enabled) { mCompressionEnabled = enabled; }
+
+    void save (juce::MemoryBlock&);
+    bool load (const void* data, int sizeInBytes);
+
+private:
+    enum Flags
+    {
+        compressed = 1 << 0
+    };
+
+    enum SectionTag
+    {
+        parametersSection   = 0x4d524150, // 'PARM'
+        settingsSection     = 0x54544553, // 'SETT'
+        presetsSection      = 0x54535250  // 'PRST'
+    };
+
+    void writeSections (juce::MemoryOutputStream&);
+    bool readSections (const void* data, size_t sizeInBytes, int version);
+    bool readSection (int tag, const void* data, size_t sizeInBytes, int version);
+    bool loadLegacyXml (const void* data, int sizeInBytes);
+    void loadLegacyXmlElement (const juce::XmlElement&);
+
+private:
+    parameters::ParameterManager*   mParameterManager;
+    settings::SettingManager*       mSettingManager;
+    presets::PresetManager*         mPresetManager;
+    bool                            mCompressionEnabled;
+    juce::MemoryBlock               mScratch;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (StateChunk)
+};
+
+//==============================================================================
+
+} // namespace state
+} // namespace grape
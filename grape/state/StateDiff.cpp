@@ -0,0 +1,195 @@
+/*
+    GRAPE is Romain's Audio Plug-in Extension classes for the JUCE framework
+
+    Copyright (c) 2018 Romain Clement
+
+    MIT License    
+    
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+    
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+ */
+
+//==============================================================================
+
+#include <grape/state/StateDiff.h>
+
+//==============================================================================
+
+namespace grape {
+namespace state {
+
+//==============================================================================
+
+static const juce::Identifier sIdProperty       = "id";
+static const juce::Identifier sValueProperty    = "value";
+static const juce::Identifier sParameterType    = "PARAM";
+
+//==============================================================================
+
+StateDiff::StateDiff()
+{
+
+}
+
+StateDiff::StateDiff (const juce::ValueTree& oldState, const juce::ValueTree& newState)
+{
+    for (int i = 0; i < oldState.getNumProperties(); ++i)
+    {
+        const auto name = oldState.getPropertyName (i);
+        const auto& oldValue = oldState.getProperty (name);
+        const auto& newValue = newState.getProperty (name);
+
+        if (!newState.hasProperty (name) || oldValue != newValue)
+            add ({ name.toString(), false, oldValue, newValue });
+    }
+
+    for (int i = 0; i < newState.getNumProperties(); ++i)
+    {
+        const auto name = newState.getPropertyName (i);
+
+        if (!oldState.hasProperty (name))
+            add ({ name.toString(), false, juce::var(), newState.getProperty (name) });
+    }
+
+    juce::HashMap<juce::String, int> newIndexes (newState.getNumChildren() * 2 + 1);
+    for (int i = 0; i < newState.getNumChildren(); ++i)
+    {
+        const auto id = newState.getChild (i).getProperty (sIdProperty).toString();
+        if (id.isNotEmpty())
+            newIndexes.set (id, i);
+    }
+
+    juce::HashMap<juce::String, int> oldIndexes (oldState.getNumChildren() * 2 + 1);
+    for (int i = 0; i < oldState.getNumChildren(); ++i)
+    {
+        const auto oldChild = oldState.getChild (i);
+        const auto id = oldChild.getProperty (sIdProperty).toString();
+        if (id.isEmpty())
+            continue;
+
+        oldIndexes.set (id, i);
+        const auto& oldValue = oldChild.getProperty (sValueProperty);
+
+        if (!newIndexes.contains (id))
+        {
+            add ({ id, true, oldValue, juce::var() });
+            continue;
+        }
+
+        const auto& newValue = newState.getChild (newIndexes[id]).getProperty (sValueProperty);
+        if (!parameterValuesAreEqual (oldValue, newValue))
+            add ({ id, true, oldValue, newValue });
+    }
+
+    for (int i = 0; i < newState.getNumChildren(); ++i)
+    {
+        const auto newChild = newState.getChild (i);
+        const auto id = newChild.getProperty (sIdProperty).toString();
+
+        if (id.isNotEmpty() && !oldIndexes.contains (id))
+            add ({ id, true, juce::var(), newChild.getProperty (sValueProperty) });
+    }
+}
+
+StateDiff::~StateDiff()
+{
+
+}
+
+//==============================================================================
+
+void StateDiff::add (const Change& change)
+{
+    mChanges.add (change);
+}
+
+bool StateDiff::contains (const juce::String& id) const
+{
+    for (const auto& change : mChanges)
+    {
+        if (change.id == id)
+            return true;
+    }
+
+    return false;
+}
+
+StateDiff StateDiff::inverted() const
+{
+    StateDiff diff;
+    diff.mChanges.ensureStorageAllocated (mChanges.size());
+
+    for (const auto& change : mChanges)
+    {
+        diff.add ({ change.id, change.isParameter, change.newValue, change.oldValue });
+    }
+
+    return diff;
+}
+
+void StateDiff::applyTo (juce::ValueTree& state, juce::UndoManager* undoManager) const
+{
+    for (const auto& change : mChanges)
+    {
+        if (!change.isParameter)
+        {
+            if (change.newValue.isVoid())
+                state.removeProperty (change.id, undoManager);
+            else
+                state.setProperty (change.id, change.newValue, undoManager);
+
+            continue;
+        }
+
+        auto child = state.getChildWithProperty (sIdProperty, change.id);
+
+        if (change.newValue.isVoid())
+        {
+            if (child.isValid())
+                state.removeChild (child, undoManager);
+        }
+        else if (child.isValid())
+        {
+            child.setProperty (sValueProperty, change.newValue, undoManager);
+        }
+        else
+        {
+            juce::ValueTree newChild (sParameterType);
+            newChild.setProperty (sIdProperty, change.id, undoManager);
+            newChild.setProperty (sValueProperty, change.newValue, undoManager);
+            state.appendChild (newChild, undoManager);
+        }
+    }
+}
+
+bool StateDiff::parameterValuesAreEqual (const juce::var& a, const juce::var& b)
+{
+    if (a.isVoid() || b.isVoid())
+        return a.isVoid() && b.isVoid();
+
+    const auto valueA = static_cast<float> (static_cast<double> (a));
+    const auto valueB = static_cast<float> (static_cast<double> (b));
+    const auto tolerance = 1.0e-6f * juce::jmax (1.0f, std::abs (valueA), std::abs (valueB));
+
+    return std::abs (valueA - valueB) <= tolerance;
+}
+
+//==============================================================================
+
+} // namespace state
+} // namespace grape
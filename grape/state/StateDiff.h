@@ -0,0 +1,80 @@
+/*
+    GRAPE is Romain's Audio Plug-in Extension classes for the JUCE framework
+
+    Copyright (c) 2018 Romain Clement
+
+    MIT License    
+    
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+    
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+ */
+
+//==============================================================================
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+
+namespace grape {
+namespace state {
+
+//==============================================================================
+
+class StateDiff
+{
+public:
+    struct Change
+    {
+        juce::String id;
+        bool isParameter;
+        juce::var oldValue;
+        juce::var newValue;
+    };
+
+public:
+    StateDiff();
+    StateDiff (const juce::ValueTree& oldState, const juce::ValueTree& newState);
+    ~StateDiff();
+
+public:
+    inline bool isEmpty() const { return mChanges.isEmpty(); }
+    inline int size() const { return mChanges.size(); }
+    inline const Change& getChange (int index) const { return mChanges.getReference (index); }
+
+    inline const Change* begin() const { return mChanges.begin(); }
+    inline const Change* end() const { return mChanges.end(); }
+
+    void add (const Change&);
+    bool contains (const juce::String& id) const;
+    StateDiff inverted() const;
+    void applyTo (juce::ValueTree&, juce::UndoManager* = nullptr) const;
+
+    static bool parameterValuesAreEqual (const juce::var&, const juce::var&);
+
+private:
+    juce::Array<Change> mChanges;
+
+    JUCE_LEAK_DETECTOR (StateDiff)
+};
+
+//==============================================================================
+
+} // namespace state
+} // namespace grape
@@ -0,0 +1,88 @@
+/*
+    GRAPE is Romain's Audio Plug-in Extension classes for the JUCE framework
+
+    Copyright (c) 2018 Romain Clement
+
+    MIT License    
+    
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+    
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+ */
+
+//==============================================================================
+
+#include <grape/state/StateHash.h>
+
+//==============================================================================
+
+namespace grape {
+namespace state {
+
+//==============================================================================
+
+static juce::uint64 mix (juce::uint64 x)
+{
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+//==============================================================================
+
+constexpr double StateHash::quantum;
+
+juce::uint64 StateHash::hashIdentifier (const juce::String& id)
+{
+    return mix (static_cast<juce::uint64> (id.hashCode64()));
+}
+
+juce::uint64 StateHash::hashParameter (juce::uint64 idHash, double value)
+{
+    const auto quantized = static_cast<juce::int64> (std::llround (value / quantum));
+    return mix (idHash ^ mix (static_cast<juce::uint64> (quantized)));
+}
+
+juce::uint64 StateHash::hashParameter (const juce::String& id, double value)
+{
+    return hashParameter (hashIdentifier (id), value);
+}
+
+juce::uint64 StateHash::hashState (const juce::ValueTree& state)
+{
+    juce::uint64 hash = 0;
+
+    for (int i = 0; i < state.getNumChildren(); ++i)
+    {
+        const auto child = state.getChild (i);
+        const auto& id = child.getProperty ("id");
+        const auto& value = child.getProperty ("value");
+
+        if (!id.isVoid() && !value.isVoid())
+        {
+            hash += hashParameter (id.toString(), static_cast<double> (value));
+        }
+    }
+
+    return hash;
+}
+
+//==============================================================================
+
+} // namespace state
+} // namespace grape
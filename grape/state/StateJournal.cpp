@@ -0,0 +1,202 @@
+/*
+    GRAPE is Romain's Audio Plug-in Extension classes for the JUCE framework
+
+    Copyright (c) 2018 Romain Clement
+
+    MIT License    
+    
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+    
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+ */
+
+//==============================================================================
+
+#include <grape/state/StateJournal.h>
+
+//==============================================================================
+
+namespace grape {
+namespace state {
+
+//==============================================================================
+
+StateJournal::StateJournal (const juce::File& journalFile,
+                            parameters::ParameterManager* parameterManager,
+                            settings::SettingManager* settingManager,
+                            presets::PresetManager* presetManager)
+    : mFile (journalFile)
+    , mParameterManager (parameterManager)
+    , mSettingManager (settingManager)
+    , mStateChunk (parameterManager, settingManager, presetManager)
+{
+    mStateChunk.setCompressionEnabled (true);
+}
+
+StateJournal::~StateJournal()
+{
+
+}
+
+//==============================================================================
+
+bool StateJournal::writeSnapshot()
+{
+    if (mParameterManager != nullptr)
+        mParameterManager->checkpoint();
+
+    if (mSettingManager != nullptr)
+        mSettingManager->checkpoint();
+
+    mStateChunk.save (mRecordData);
+
+    const auto parentDir = mFile.getParentDirectory();
+    if (!parentDir.exists())
+    {
+        parentDir.createDirectory();
+    }
+
+    juce::TemporaryFile tempFile (mFile);
+    {
+        juce::FileOutputStream output (tempFile.getFile());
+        if (!output.openedOk() || !writeRecord (output, snapshotRecord, mRecordData))
+            return false;
+    }
+
+    return tempFile.overwriteTargetFileWithTemporary();
+}
+
+bool StateJournal::appendChanges()
+{
+    const auto parametersChanged = (
+        mParameterManager != nullptr && mParameterManager->hasChangesSinceCheckpoint()
+    );
+    const auto settingsChanged = (
+        mSettingManager != nullptr && mSettingManager->hasChangesSinceCheckpoint()
+    );
+
+    if (!mFile.existsAsFile())
+        return writeSnapshot();
+
+    if (!parametersChanged && !settingsChanged)
+        return true;
+
+    {
+        juce::MemoryOutputStream payload (mRecordData, false);
+
+        if (mParameterManager != nullptr)
+            mParameterManager->writeChangesToStream (payload);
+        else
+            payload.writeCompressedInt (0);
+
+        if (mSettingManager != nullptr)
+            mSettingManager->writeChangesToStream (payload);
+        else
+            payload.writeCompressedInt (0);
+    }
+
+    juce::FileOutputStream output (mFile);
+    if (output.openedOk() && writeRecord (output, deltaRecord, mRecordData))
+        return true;
+
+    // Whatever did not reach the file goes into the next record
+    if (mParameterManager != nullptr)
+        mParameterManager->restoreWrittenChanges();
+
+    if (mSettingManager != nullptr)
+        mSettingManager->restoreWrittenChanges();
+
+    return false;
+}
+
+bool StateJournal::recover()
+{
+    juce::FileInputStream input (mFile);
+    if (!input.openedOk())
+        return false;
+
+    int tag = 0;
+    if (!readRecord (input, tag)
+        || tag != snapshotRecord
+        || !mStateChunk.load (mRecordData.getData(), static_cast<int> (mRecordData.getSize())))
+    {
+        return false;
+    }
+
+    while (readRecord (input, tag))
+    {
+        if (tag == deltaRecord)
+        {
+            applyChanges();
+        }
+    }
+
+    return true;
+}
+
+void StateJournal::clear()
+{
+    mFile.deleteFile();
+}
+
+//==============================================================================
+
+bool StateJournal::writeRecord (juce::OutputStream& output, int tag, const juce::MemoryBlock& data)
+{
+    const auto written = (
+        output.writeInt (tag)
+        && output.writeInt (static_cast<int> (data.getSize()))
+        && output.write (data.getData(), data.getSize())
+    );
+
+    output.flush();
+    return written;
+}
+
+bool StateJournal::readRecord (juce::InputStream& input, int& tag)
+{
+    if (input.getNumBytesRemaining() < 8)
+        return false;
+
+    tag = input.readInt();
+    const auto size = input.readInt();
+
+    if (size < 0 || input.getNumBytesRemaining() < size)
+        return false;
+
+    mRecordData.setSize (static_cast<size_t> (size), false);
+    return input.read (mRecordData.getData(), size) == size;
+}
+
+void StateJournal::applyChanges()
+{
+    juce::MemoryInputStream input (mRecordData, false);
+
+    const auto parametersRead = (
+        mParameterManager != nullptr
+        ? mParameterManager->readChangesFromStream (input)
+        : input.readCompressedInt() == 0
+    );
+
+    if (parametersRead && mSettingManager != nullptr)
+        mSettingManager->readFromStream (input);
+}
+
+//==============================================================================
+
+} // namespace state
+} // namespace grape
@@ -0,0 +1,141 @@
+/*
+    GRAPE is Romain's Audio Plug-in Extension classes for the JUCE framework
+
+    Copyright (c) 2018 Romain Clement
+
+    MIT License    
+    
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+    
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+ */
+
+//==============================================================================
+
+#include <grape/state/StateXml.h>
+#include <grape/helpers/Profiler.h>
+
+//==============================================================================
+
+namespace grape {
+namespace state {
+
+//==============================================================================
+
+static const int sXmlBinaryMagic = 0x21324356; // AudioProcessor::copyXmlToBinary
+
+//==============================================================================
+
+StateXml::StateXml (parameters::ParameterManager* parameterManager,
+                    settings::SettingManager* settingManager,
+                    presets::PresetManager* presetManager,
+                    const juce::String& tagName)
+    : mParameterManager (parameterManager)
+    , mSettingManager (settingManager)
+    , mPresetManager (presetManager)
+    , mTagName (tagName)
+{
+
+}
+
+StateXml::~StateXml()
+{
+
+}
+
+//==============================================================================
+
+const XmlStreamWriter& StateXml::save()
+{
+    GRAPE_PROFILE_SCOPE ("StateXml::save");
+
+    mWriter.reset();
+    mWriter.startElement (mTagName);
+
+    if (mParameterManager != nullptr)
+        mParameterManager->writeXml (mWriter);
+
+    if (mSettingManager != nullptr)
+        mSettingManager->writeXml (mWriter);
+
+    if (mPresetManager != nullptr)
+        mPresetManager->writeXml (mWriter);
+
+    mWriter.endElement (mTagName);
+    return mWriter;
+}
+
+void StateXml::save (juce::MemoryBlock& destData)
+{
+    GRAPE_PROFILE_SCOPE ("StateXml::save");
+
+    const auto& writer = save();
+    destData.replaceWith (writer.getData(), writer.getDataSize());
+}
+
+bool StateXml::load (const void* data, size_t sizeInBytes)
+{
+    GRAPE_PROFILE_SCOPE ("StateXml::load");
+
+    if (data == nullptr)
+        return false;
+
+    auto xmlData = static_cast<const char*> (data);
+
+    if (sizeInBytes > 8
+        && static_cast<int> (juce::ByteOrder::littleEndianInt (xmlData)) == sXmlBinaryMagic)
+    {
+        xmlData += 8;
+        sizeInBytes -= 8;
+    }
+
+    XmlStreamReader reader (xmlData, sizeInBytes);
+
+    if (reader.next() != XmlStreamReader::startElement)
+        return false;
+
+    if (readManagerXml (reader))
+        return true;
+
+    for (;;)
+    {
+        const auto token = reader.next();
+
+        if (token == XmlStreamReader::endElement)
+            return true;
+
+        if (token != XmlStreamReader::startElement)
+            return false;
+
+        if (!readManagerXml (reader) && !reader.skipElement())
+            return false;
+    }
+}
+
+//==============================================================================
+
+bool StateXml::readManagerXml (XmlStreamReader& reader)
+{
+    return (mParameterManager != nullptr && mParameterManager->readXml (reader))
+        || (mSettingManager != nullptr && mSettingManager->readXml (reader))
+        || (mPresetManager != nullptr && mPresetManager->readXml (reader));
+}
+
+//==============================================================================
+
+} // namespace state
+} // namespace grape
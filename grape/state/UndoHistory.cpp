@@ -0,0 +1,338 @@
+/*
+    GRAPE is Romain's Audio Plug-in Extension classes for the JUCE framework
+
+    Copyright (c) 2018 Romain Clement
+
+    MIT License    
+    
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+    
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+ */
+
+//==============================================================================
+
+#include <grape/state/UndoHistory.h>
+
+//==============================================================================
+
+namespace grape {
+namespace state {
+
+//==============================================================================
+
+bool UndoHistory::Transaction::isEmpty() const
+{
+    return parameters.isEmpty() && settings.isEmpty();
+}
+
+size_t UndoHistory::Transaction::computeMemoryUsage() const
+{
+    auto usage = sizeof (Transaction)
+        + static_cast<size_t> (parameters.size()) * sizeof (ParameterChange)
+        + static_cast<size_t> (settings.size()) * sizeof (SettingChange);
+
+    for (const auto& s : settings)
+    {
+        usage += s.id.getNumBytesAsUTF8()
+            + s.oldValue.toString().getNumBytesAsUTF8()
+            + s.newValue.toString().getNumBytesAsUTF8();
+    }
+
+    return usage;
+}
+
+//==============================================================================
+
+UndoHistory::UndoHistory (parameters::ParameterManager& parameterManager,
+                          settings::SettingManager* settingManager,
+                          size_t memoryBudget)
+    : mParameterManager (parameterManager)
+    , mSettingManager (settingManager)
+    , mMemoryBudget (memoryBudget)
+    , mMemoryUsage (0)
+    , mTransactionStartValues (static_cast<size_t> (parameterManager.getNumParameters()))
+    , mNotifiedValues (static_cast<size_t> (parameterManager.getNumParameters()))
+    , mNumOpenGestures (0)
+    , mNumOpenTransactions (0)
+    , mApplying (false)
+{
+    for (int i = 0; i < mParameterManager.getNumParameters(); ++i)
+    {
+        auto param = mParameterManager.getParameterByIndex (i);
+        mNotifiedValues[static_cast<size_t> (i)].store (param->getValue());
+        param->addListener (this);
+    }
+
+    if (mSettingManager != nullptr)
+    {
+        mSettingsSnapshot = mSettingManager->copyState();
+        mSettingManager->addListener (this);
+    }
+}
+
+UndoHistory::~UndoHistory()
+{
+    if (mSettingManager != nullptr)
+    {
+        mSettingManager->removeListener (this);
+    }
+
+    for (int i = 0; i < mParameterManager.getNumParameters(); ++i)
+    {
+        mParameterManager.getParameterByIndex (i)->removeListener (this);
+    }
+}
+
+//==============================================================================
+
+void UndoHistory::beginTransaction()
+{
+    if (mNumOpenTransactions++ > 0)
+        return;
+
+    for (int i = 0; i < mParameterManager.getNumParameters(); ++i)
+    {
+        mTransactionStartValues[static_cast<size_t> (i)] = mParameterManager.getParameterByIndex (i)->getValue();
+    }
+}
+
+void UndoHistory::endTransaction()
+{
+    jassert (mNumOpenTransactions > 0);
+
+    if (mNumOpenTransactions <= 0 || --mNumOpenTransactions > 0)
+        return;
+
+    for (int i = 0; i < mParameterManager.getNumParameters(); ++i)
+    {
+        const auto startValue = mTransactionStartValues[static_cast<size_t> (i)];
+
+        if (mParameterManager.getParameterByIndex (i)->getValue() != startValue)
+            trackParameter (i, startValue);
+    }
+
+    if (!isTransactionOpen())
+        commitPendingTransaction();
+}
+
+bool UndoHistory::canUndo() const
+{
+    return !mUndoTransactions.isEmpty();
+}
+
+bool UndoHistory::canRedo() const
+{
+    return !mRedoTransactions.isEmpty();
+}
+
+bool UndoHistory::undo()
+{
+    if (!canUndo() || isTransactionOpen())
+        return false;
+
+    auto transaction = mUndoTransactions.removeAndReturn (mUndoTransactions.size() - 1);
+    applyTransaction (*transaction, true);
+    mRedoTransactions.add (transaction);
+    return true;
+}
+
+bool UndoHistory::redo()
+{
+    if (!canRedo() || isTransactionOpen())
+        return false;
+
+    auto transaction = mRedoTransactions.removeAndReturn (mRedoTransactions.size() - 1);
+    applyTransaction (*transaction, false);
+    mUndoTransactions.add (transaction);
+    return true;
+}
+
+void UndoHistory::clear()
+{
+    mUndoTransactions.clear();
+    mRedoTransactions.clear();
+    mMemoryUsage = 0;
+}
+
+void UndoHistory::setMemoryBudget (size_t memoryBudget)
+{
+    mMemoryBudget = memoryBudget;
+    enforceMemoryBudget();
+}
+
+//==============================================================================
+
+void UndoHistory::parameterValueChanged (int parameterIndex, float newValue)
+{
+    const auto index = mParameterManager.indexOfProcessorParameter (parameterIndex);
+    if (index >= 0)
+    {
+        mNotifiedValues[static_cast<size_t> (index)].store (newValue);
+    }
+}
+
+void UndoHistory::parameterGestureChanged (int parameterIndex, bool gestureIsStarting)
+{
+    if (mApplying)
+        return;
+
+    const auto index = mParameterManager.indexOfProcessorParameter (parameterIndex);
+    if (index < 0)
+        return;
+
+    if (gestureIsStarting)
+    {
+        // Values ramped in without notification (async preset loads) are
+        // announced inside a gesture, so the old value is the last one seen
+        trackParameter (index, mNotifiedValues[static_cast<size_t> (index)].load());
+        ++mNumOpenGestures;
+    }
+    else if (mNumOpenGestures > 0 && --mNumOpenGestures == 0 && !isTransactionOpen())
+    {
+        commitPendingTransaction();
+    }
+}
+
+void UndoHistory::settingChanged (const juce::String& id, const juce::var& value)
+{
+    const juce::Identifier name (id);
+    const auto oldValue = mSettingsSnapshot.getProperty (name);
+    mSettingsSnapshot.setProperty (name, value, nullptr);
+
+    if (mApplying || oldValue == value)
+        return;
+
+    trackSetting (id, oldValue);
+
+    if (!isTransactionOpen())
+        commitPendingTransaction();
+}
+
+//==============================================================================
+
+void UndoHistory::trackParameter (int index, float oldValue)
+{
+    for (const auto& p : mPendingTransaction.parameters)
+    {
+        if (p.index == index)
+            return;
+    }
+
+    mPendingTransaction.parameters.add ({ index, oldValue, oldValue });
+}
+
+void UndoHistory::trackSetting (const juce::String& id, const juce::var& oldValue)
+{
+    for (const auto& s : mPendingTransaction.settings)
+    {
+        if (s.id == id)
+            return;
+    }
+
+    mPendingTransaction.settings.add ({ id, oldValue, oldValue });
+}
+
+void UndoHistory::commitPendingTransaction()
+{
+    auto transaction = new Transaction();
+
+    for (const auto& p : mPendingTransaction.parameters)
+    {
+        const auto newValue = mParameterManager.getParameterByIndex (p.index)->getValue();
+        if (newValue != p.oldValue)
+            transaction->parameters.add ({ p.index, p.oldValue, newValue });
+    }
+
+    for (const auto& s : mPendingTransaction.settings)
+    {
+        const auto& newValue = mSettingsSnapshot.getProperty (s.id);
+        if (newValue != s.oldValue)
+            transaction->settings.add ({ s.id, s.oldValue, newValue });
+    }
+
+    mPendingTransaction.parameters.clearQuick();
+    mPendingTransaction.settings.clearQuick();
+
+    if (transaction->isEmpty())
+    {
+        delete transaction;
+        return;
+    }
+
+    transaction->parameters.minimiseStorageOverheads();
+    transaction->settings.minimiseStorageOverheads();
+    transaction->memoryUsage = transaction->computeMemoryUsage();
+
+    clearRedoTransactions();
+    mUndoTransactions.add (transaction);
+    mMemoryUsage += transaction->memoryUsage;
+    enforceMemoryBudget();
+}
+
+void UndoHistory::applyTransaction (const Transaction& transaction, bool useOldValues)
+{
+    const juce::ScopedValueSetter<bool> applying (mApplying, true);
+
+    for (const auto& p : transaction.parameters)
+    {
+        auto param = mParameterManager.getParameterByIndex (p.index);
+        param->setValueNotifyingHost (useOldValues ? p.oldValue : p.newValue);
+    }
+
+    if (mSettingManager != nullptr)
+    {
+        for (const auto& s : transaction.settings)
+        {
+            mSettingManager->setSetting (s.id, useOldValues ? s.oldValue : s.newValue);
+        }
+    }
+}
+
+void UndoHistory::clearRedoTransactions()
+{
+    for (auto* t : mRedoTransactions)
+    {
+        mMemoryUsage -= t->memoryUsage;
+    }
+
+    mRedoTransactions.clear();
+}
+
+void UndoHistory::enforceMemoryBudget()
+{
+    // The oldest undo steps go first, then the redo steps furthest from the
+    // current state. The most recent step is always kept.
+    while (mMemoryUsage > mMemoryBudget && mUndoTransactions.size() > 1)
+    {
+        mMemoryUsage -= mUndoTransactions.getUnchecked (0)->memoryUsage;
+        mUndoTransactions.remove (0);
+    }
+
+    const auto numKeptRedo = mUndoTransactions.isEmpty() ? 1 : 0;
+
+    while (mMemoryUsage > mMemoryBudget && mRedoTransactions.size() > numKeptRedo)
+    {
+        mMemoryUsage -= mRedoTransactions.getUnchecked (0)->memoryUsage;
+        mRedoTransactions.remove (0);
+    }
+}
+
+//==============================================================================
+
+} // namespace state
+} // namespace grape
@@ -0,0 +1,131 @@
+/*
+    GRAPE is Romain's Audio Plug-in Extension classes for the JUCE framework
+
+    Copyright (c) 2018 Romain Clement
+
+    MIT License    
+    
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+    
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+ */
+
+//==============================================================================
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <grape/parameters/ParameterManager.h>
+#include <grape/settings/SettingManager.h>
+#include <atomic>
+#include <vector>
+
+//==============================================================================
+
+namespace grape {
+namespace state {
+
+//==============================================================================
+
+class UndoHistory : private juce::AudioProcessorParameter::Listener,
+                    private settings::SettingManager::Listener
+{
+public:
+    UndoHistory (parameters::ParameterManager&,
+                 settings::SettingManager* = nullptr,
+                 size_t memoryBudget = 256 * 1024);
+    ~UndoHistory();
+
+public:
+    void beginTransaction();
+    void endTransaction();
+
+    bool canUndo() const;
+    bool canRedo() const;
+    bool undo();
+    bool redo();
+    void clear();
+
+    inline int getNumTransactions() const { return mUndoTransactions.size(); }
+    inline size_t getMemoryUsage() const { return mMemoryUsage; }
+    inline size_t getMemoryBudget() const { return mMemoryBudget; }
+    void setMemoryBudget (size_t);
+
+private:
+    struct ParameterChange
+    {
+        int index;
+        float oldValue;
+        float newValue;
+    };
+
+    struct SettingChange
+    {
+        juce::String id;
+        juce::var oldValue;
+        juce::var newValue;
+    };
+
+    struct Transaction
+    {
+        juce::Array<ParameterChange> parameters;
+        juce::Array<SettingChange> settings;
+        size_t memoryUsage = 0;
+
+        bool isEmpty() const;
+        size_t computeMemoryUsage() const;
+    };
+
+private: // juce::AudioProcessorParameter::Listener
+    void parameterValueChanged (int, float) override;
+    void parameterGestureChanged (int, bool) override;
+
+private: // settings::SettingManager::Listener
+    void settingChanged (const juce::String&, const juce::var&) override;
+
+private:
+    inline bool isTransactionOpen() const { return mNumOpenGestures > 0 || mNumOpenTransactions > 0; }
+
+    void trackParameter (int index, float oldValue);
+    void trackSetting (const juce::String& id, const juce::var& oldValue);
+    void commitPendingTransaction();
+    void applyTransaction (const Transaction&, bool useOldValues);
+    void clearRedoTransactions();
+    void enforceMemoryBudget();
+
+private:
+    parameters::ParameterManager&   mParameterManager;
+    settings::SettingManager*       mSettingManager;
+    size_t                          mMemoryBudget;
+    size_t                          mMemoryUsage;
+    juce::OwnedArray<Transaction>   mUndoTransactions;
+    juce::OwnedArray<Transaction>   mRedoTransactions;
+    Transaction                     mPendingTransaction;
+    std::vector<float>              mTransactionStartValues;
+    std::vector<std::atomic<float>> mNotifiedValues;
+    juce::ValueTree                 mSettingsSnapshot;
+    int                             mNumOpenGestures;
+    int                             mNumOpenTransactions;
+    bool                            mApplying;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (UndoHistory)
+};
+
+//==============================================================================
+
+} // namespace state
+} // namespace grape
@@ -0,0 +1,467 @@
+/*
+    GRAPE is Romain's Audio Plug-in Extension classes for the JUCE framework
+
+    Copyright (c) 2018 Romain Clement
+
+    MIT License    
+    
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+    
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+ */
+
+//==============================================================================
+
+#include <grape/state/XmlStreamReader.h>
+#include <cstring>
+
+//==============================================================================
+
+namespace grape {
+namespace state {
+
+//==============================================================================
+
+static bool startsWith (const char* text, const char* end, const char* prefix)
+{
+    const auto length = std::strlen (prefix);
+    return static_cast<size_t> (end - text) >= length
+        && std::memcmp (text, prefix, length) == 0;
+}
+
+static bool isNameTerminator (char c)
+{
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n'
+        || c == '/' || c == '>' || c == '=';
+}
+
+//==============================================================================
+
+XmlStreamReader::XmlStreamReader (const void* data, size_t sizeInBytes)
+    : mCurrent (static_cast<const char*> (data))
+    , mEnd (static_cast<const char*> (data) + sizeInBytes)
+    , mDepth (0)
+    , mPendingEnd (false)
+    , mTagName { nullptr, nullptr }
+{
+    if (startsWith (mCurrent, mEnd, "\xef\xbb\xbf"))
+    {
+        mCurrent += 3;
+    }
+
+    mAttributes.ensureStorageAllocated (16);
+}
+
+XmlStreamReader::~XmlStreamReader()
+{
+
+}
+
+//==============================================================================
+
+XmlStreamReader::Token XmlStreamReader::next()
+{
+    if (mPendingEnd)
+    {
+        mPendingEnd = false;
+        mAttributes.clearQuick();
+        --mDepth;
+        return endElement;
+    }
+
+    for (;;)
+    {
+        while (mCurrent < mEnd && *mCurrent != '<')
+        {
+            ++mCurrent;
+        }
+
+        if (mCurrent >= mEnd)
+            return endOfDocument;
+
+        if (startsWith (mCurrent, mEnd, "<?"))
+        {
+            if (!skipPast ("?>"))
+                return parseError;
+        }
+        else if (startsWith (mCurrent, mEnd, "<!--"))
+        {
+            if (!skipPast ("-->"))
+                return parseError;
+        }
+        else if (startsWith (mCurrent, mEnd, "<![CDATA["))
+        {
+            if (!skipPast ("]]>"))
+                return parseError;
+        }
+        else if (startsWith (mCurrent, mEnd, "<!"))
+        {
+            if (!skipPast (">"))
+                return parseError;
+        }
+        else if (startsWith (mCurrent, mEnd, "</"))
+        {
+            return readEndElement();
+        }
+        else
+        {
+            return readStartElement();
+        }
+    }
+}
+
+bool XmlStreamReader::skipElement()
+{
+    const auto depth = mDepth;
+
+    for (;;)
+    {
+        const auto token = next();
+
+        if (token == endElement && mDepth < depth)
+            return true;
+
+        if (token == endOfDocument || token == parseError)
+            return false;
+    }
+}
+
+juce::ValueTree XmlStreamReader::readValueTree()
+{
+    juce::ValueTree tree { juce::Identifier (getTagName()) };
+
+    for (int i = 0; i < mAttributes.size(); ++i)
+    {
+        tree.setProperty (juce::Identifier (getAttributeName (i)), getAttributeValue (i), nullptr);
+    }
+
+    for (;;)
+    {
+        const auto token = next();
+
+        if (token == startElement)
+        {
+            const auto child = readValueTree();
+            if (!child.isValid())
+                return juce::ValueTree();
+
+            tree.appendChild (child, nullptr);
+        }
+        else if (token == endElement)
+        {
+            return tree;
+        }
+        else
+        {
+            return juce::ValueTree();
+        }
+    }
+}
+
+bool XmlStreamReader::hasTagName (juce::StringRef tagName) const
+{
+    return rangeMatches (mTagName, tagName);
+}
+
+juce::String XmlStreamReader::getTagName() const
+{
+    return rangeToString (mTagName, false);
+}
+
+int XmlStreamReader::findAttribute (juce::StringRef name) const
+{
+    for (int i = 0; i < mAttributes.size(); ++i)
+    {
+        if (rangeMatches (mAttributes.getReference (i).name, name))
+            return i;
+    }
+
+    return -1;
+}
+
+juce::String XmlStreamReader::getAttributeName (int index) const
+{
+    return rangeToString (mAttributes.getReference (index).name, false);
+}
+
+juce::String XmlStreamReader::getAttributeValue (int index) const
+{
+    const auto& attribute = mAttributes.getReference (index);
+    return rangeToString (attribute.value, attribute.hasEntities);
+}
+
+bool XmlStreamReader::attributeValueMatches (int index, juce::StringRef text) const
+{
+    const auto& attribute = mAttributes.getReference (index);
+
+    if (attribute.hasEntities)
+        return getAttributeValue (index) == text;
+
+    return rangeMatches (attribute.value, text);
+}
+
+juce::String XmlStreamReader::getStringAttribute (juce::StringRef name,
+                                                  const juce::String& defaultValue) const
+{
+    const auto index = findAttribute (name);
+    return index >= 0 ? getAttributeValue (index) : defaultValue;
+}
+
+int XmlStreamReader::getIntAttribute (juce::StringRef name, int defaultValue) const
+{
+    const auto index = findAttribute (name);
+    if (index < 0)
+        return defaultValue;
+
+    const juce::CharPointer_UTF8 text (mAttributes.getReference (index).value.start);
+    return juce::CharacterFunctions::getIntValue<int, juce::CharPointer_UTF8> (text);
+}
+
+double XmlStreamReader::getDoubleAttribute (juce::StringRef name, double defaultValue) const
+{
+    const auto index = findAttribute (name);
+    if (index < 0)
+        return defaultValue;
+
+    juce::CharPointer_UTF8 text (mAttributes.getReference (index).value.start);
+    return juce::CharacterFunctions::readDoubleValue (text);
+}
+
+bool XmlStreamReader::getBoolAttribute (juce::StringRef name, bool defaultValue) const
+{
+    const auto index = findAttribute (name);
+    if (index < 0)
+        return defaultValue;
+
+    const auto& value = mAttributes.getReference (index).value;
+    auto p = value.start;
+    while (p < value.end && (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n'))
+    {
+        ++p;
+    }
+
+    return p < value.end
+        && (*p == '1' || *p == 't' || *p == 'T' || *p == 'y' || *p == 'Y');
+}
+
+//==============================================================================
+
+bool XmlStreamReader::rangeMatches (const Range& range, juce::StringRef text)
+{
+    const auto length = std::strlen (text.text.getAddress());
+    return static_cast<size_t> (range.end - range.start) == length
+        && std::memcmp (range.start, text.text.getAddress(), length) == 0;
+}
+
+juce::String XmlStreamReader::rangeToString (const Range& range, bool decodeEntities)
+{
+    const auto length = static_cast<int> (range.end - range.start);
+
+    if (!decodeEntities)
+        return juce::String::fromUTF8 (range.start, length);
+
+    juce::MemoryOutputStream output (static_cast<size_t> (length) + 1);
+
+    for (auto p = range.start; p < range.end; ++p)
+    {
+        if (*p != '&')
+        {
+            output.writeByte (*p);
+            continue;
+        }
+
+        auto semicolon = p + 1;
+        while (semicolon < range.end && *semicolon != ';')
+        {
+            ++semicolon;
+        }
+
+        if (semicolon >= range.end)
+        {
+            output.writeByte (*p);
+            continue;
+        }
+
+        const Range entity { p + 1, semicolon };
+
+        if (rangeMatches (entity, "amp"))
+            output.writeByte ('&');
+        else if (rangeMatches (entity, "lt"))
+            output.writeByte ('<');
+        else if (rangeMatches (entity, "gt"))
+            output.writeByte ('>');
+        else if (rangeMatches (entity, "quot"))
+            output.writeByte ('"');
+        else if (rangeMatches (entity, "apos"))
+            output.writeByte ('\'');
+        else if (entity.start < entity.end && *entity.start == '#')
+        {
+            juce::uint32 code = 0;
+            const auto hex = entity.start + 1 < entity.end
+                && (entity.start[1] == 'x' || entity.start[1] == 'X');
+
+            for (auto d = entity.start + (hex ? 2 : 1); d < entity.end; ++d)
+            {
+                const auto digit = juce::CharacterFunctions::getHexDigitValue (
+                    static_cast<juce::juce_wchar> (*d)
+                );
+
+                if (digit < 0 || (!hex && digit > 9))
+                    break;
+
+                code = code * (hex ? 16u : 10u) + static_cast<juce::uint32> (digit);
+            }
+
+            output.appendUTF8Char (static_cast<juce::juce_wchar> (code));
+        }
+        else
+        {
+            output.write (p, static_cast<size_t> (semicolon - p + 1));
+        }
+
+        p = semicolon;
+    }
+
+    return output.toUTF8();
+}
+
+bool XmlStreamReader::skipPast (const char* terminator)
+{
+    const auto length = std::strlen (terminator);
+
+    while (mCurrent < mEnd)
+    {
+        if (startsWith (mCurrent, mEnd, terminator))
+        {
+            mCurrent += length;
+            return true;
+        }
+
+        ++mCurrent;
+    }
+
+    return false;
+}
+
+void XmlStreamReader::skipWhitespace()
+{
+    while (mCurrent < mEnd
+           && (*mCurrent == ' ' || *mCurrent == '\t' || *mCurrent == '\r' || *mCurrent == '\n'))
+    {
+        ++mCurrent;
+    }
+}
+
+bool XmlStreamReader::readName (Range& name)
+{
+    name.start = mCurrent;
+
+    while (mCurrent < mEnd && !isNameTerminator (*mCurrent))
+    {
+        ++mCurrent;
+    }
+
+    name.end = mCurrent;
+    return name.end > name.start;
+}
+
+XmlStreamReader::Token XmlStreamReader::readStartElement()
+{
+    ++mCurrent;
+    mAttributes.clearQuick();
+
+    if (!readName (mTagName))
+        return parseError;
+
+    for (;;)
+    {
+        skipWhitespace();
+
+        if (mCurrent >= mEnd)
+            return parseError;
+
+        if (*mCurrent == '/')
+        {
+            if (!startsWith (mCurrent, mEnd, "/>"))
+                return parseError;
+
+            mCurrent += 2;
+            mPendingEnd = true;
+            ++mDepth;
+            return startElement;
+        }
+
+        if (*mCurrent == '>')
+        {
+            ++mCurrent;
+            ++mDepth;
+            return startElement;
+        }
+
+        Attribute attribute;
+        attribute.hasEntities = false;
+
+        if (!readName (attribute.name))
+            return parseError;
+
+        skipWhitespace();
+        if (mCurrent >= mEnd || *mCurrent != '=')
+            return parseError;
+
+        ++mCurrent;
+        skipWhitespace();
+        if (mCurrent >= mEnd || (*mCurrent != '"' && *mCurrent != '\''))
+            return parseError;
+
+        const auto quote = *mCurrent++;
+        attribute.value.start = mCurrent;
+
+        while (mCurrent < mEnd && *mCurrent != quote)
+        {
+            attribute.hasEntities = attribute.hasEntities || *mCurrent == '&';
+            ++mCurrent;
+        }
+
+        if (mCurrent >= mEnd)
+            return parseError;
+
+        attribute.value.end = mCurrent++;
+        mAttributes.add (attribute);
+    }
+}
+
+XmlStreamReader::Token XmlStreamReader::readEndElement()
+{
+    mCurrent += 2;
+    mAttributes.clearQuick();
+
+    if (!readName (mTagName))
+        return parseError;
+
+    skipWhitespace();
+    if (mCurrent >= mEnd || *mCurrent != '>')
+        return parseError;
+
+    ++mCurrent;
+    --mDepth;
+    return endElement;
+}
+
+//==============================================================================
+
+} // namespace state
+} // namespace grape
@@ -0,0 +1,114 @@
+/*
+    GRAPE is Romain's Audio Plug-in Extension classes for the JUCE framework
+
+    Copyright (c) 2018 Romain Clement
+
+    MIT License    
+    
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+    
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+ */
+
+//==============================================================================
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+
+namespace grape {
+namespace state {
+
+//==============================================================================
+
+class XmlStreamReader
+{
+public:
+    enum Token
+    {
+        startElement,
+        endElement,
+        endOfDocument,
+        parseError
+    };
+
+public:
+    XmlStreamReader (const void* data, size_t sizeInBytes);
+    ~XmlStreamReader();
+
+public:
+    Token next();
+    bool skipElement();
+    juce::ValueTree readValueTree();
+
+    inline int getDepth() const { return mDepth; }
+
+    bool hasTagName (juce::StringRef) const;
+    juce::String getTagName() const;
+
+    inline int getNumAttributes() const { return mAttributes.size(); }
+    int findAttribute (juce::StringRef) const;
+    juce::String getAttributeName (int) const;
+    juce::String getAttributeValue (int) const;
+    bool attributeValueMatches (int, juce::StringRef) const;
+
+    juce::String getStringAttribute (juce::StringRef,
+                                     const juce::String& defaultValue = juce::String()) const;
+    int getIntAttribute (juce::StringRef, int defaultValue = 0) const;
+    double getDoubleAttribute (juce::StringRef, double defaultValue = 0.0) const;
+    bool getBoolAttribute (juce::StringRef, bool defaultValue = false) const;
+
+private:
+    struct Range
+    {
+        const char* start;
+        const char* end;
+    };
+
+    struct Attribute
+    {
+        Range name;
+        Range value;
+        bool hasEntities;
+    };
+
+    static bool rangeMatches (const Range&, juce::StringRef);
+    static juce::String rangeToString (const Range&, bool decodeEntities);
+
+    bool skipPast (const char* terminator);
+    void skipWhitespace();
+    bool readName (Range&);
+    Token readStartElement();
+    Token readEndElement();
+
+private:
+    const char*             mCurrent;
+    const char*             mEnd;
+    int                     mDepth;
+    bool                    mPendingEnd;
+    Range                   mTagName;
+    juce::Array<Attribute>  mAttributes;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (XmlStreamReader)
+};
+
+//==============================================================================
+
+} // namespace state
+} // namespace grape
@@ -0,0 +1,221 @@
+/*
+    GRAPE is Romain's Audio Plug-in Extension classes for the JUCE framework
+
+    Copyright (c) 2018 Romain Clement
+
+    MIT License    
+    
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+    
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+ */
+
+//==============================================================================
+
+#include <grape/state/XmlStreamWriter.h>
+#include <cstdio>
+#include <cstring>
+
+//==============================================================================
+
+namespace grape {
+namespace state {
+
+//==============================================================================
+
+XmlStreamWriter::XmlStreamWriter (size_t initialSize)
+    : mOutput (initialSize)
+    , mStartTagOpen (false)
+{
+
+}
+
+XmlStreamWriter::~XmlStreamWriter()
+{
+
+}
+
+//==============================================================================
+
+void XmlStreamWriter::reset()
+{
+    mOutput.reset();
+    mStartTagOpen = false;
+}
+
+void XmlStreamWriter::writeHeader()
+{
+    writeRaw ("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n");
+}
+
+void XmlStreamWriter::startElement (juce::StringRef tagName)
+{
+    if (mStartTagOpen)
+    {
+        writeRaw (">");
+    }
+
+    writeRaw ("<");
+    writeRaw (tagName.text.getAddress());
+    mStartTagOpen = true;
+}
+
+void XmlStreamWriter::endElement (juce::StringRef tagName)
+{
+    if (mStartTagOpen)
+    {
+        writeRaw ("/>");
+        mStartTagOpen = false;
+        return;
+    }
+
+    writeRaw ("</");
+    writeRaw (tagName.text.getAddress());
+    writeRaw (">");
+}
+
+void XmlStreamWriter::writeAttribute (juce::StringRef name, juce::StringRef value)
+{
+    writeAttributeName (name);
+    writeEscaped (value.text.getAddress());
+    writeRaw ("\"");
+}
+
+void XmlStreamWriter::writeAttribute (juce::StringRef name, int value)
+{
+    char number[32];
+    std::snprintf (number, sizeof (number), "%d", value);
+    writeNumberAttribute (name, number);
+}
+
+void XmlStreamWriter::writeAttribute (juce::StringRef name, juce::int64 value)
+{
+    char number[32];
+    std::snprintf (number, sizeof (number), "%lld", static_cast<long long> (value));
+    writeNumberAttribute (name, number);
+}
+
+void XmlStreamWriter::writeAttribute (juce::StringRef name, float value)
+{
+    char number[32];
+    std::snprintf (number, sizeof (number), "%.9g", static_cast<double> (value));
+    writeNumberAttribute (name, number);
+}
+
+void XmlStreamWriter::writeAttribute (juce::StringRef name, double value)
+{
+    char number[32];
+    std::snprintf (number, sizeof (number), "%.17g", value);
+    writeNumberAttribute (name, number);
+}
+
+void XmlStreamWriter::writeVarAttribute (juce::StringRef name, const juce::var& value)
+{
+    if (value.isInt())
+        writeAttribute (name, static_cast<int> (value));
+    else if (value.isInt64())
+        writeAttribute (name, static_cast<juce::int64> (value));
+    else if (value.isBool())
+        writeAttribute (name, static_cast<bool> (value) ? 1 : 0);
+    else if (value.isDouble())
+        writeAttribute (name, static_cast<double> (value));
+    else
+        writeAttribute (name, juce::StringRef (value.toString()));
+}
+
+void XmlStreamWriter::writeValueTree (const juce::ValueTree& tree)
+{
+    const auto& tagName = tree.getType().toString();
+    startElement (tagName);
+
+    for (int i = 0; i < tree.getNumProperties(); ++i)
+    {
+        const auto name = tree.getPropertyName (i);
+        writeVarAttribute (name.toString(), tree.getProperty (name));
+    }
+
+    for (int i = 0; i < tree.getNumChildren(); ++i)
+    {
+        writeValueTree (tree.getChild (i));
+    }
+
+    endElement (tagName);
+}
+
+//==============================================================================
+
+void XmlStreamWriter::writeRaw (const char* text)
+{
+    mOutput.write (text, std::strlen (text));
+}
+
+void XmlStreamWriter::writeEscaped (const char* text)
+{
+    auto start = text;
+
+    for (auto p = text; *p != 0; ++p)
+    {
+        const char* entity = nullptr;
+
+        switch (*p)
+        {
+            case '&':   entity = "&amp;";   break;
+            case '<':   entity = "&lt;";    break;
+            case '>':   entity = "&gt;";    break;
+            case '"':   entity = "&quot;";  break;
+            case '\n':  entity = "&#10;";   break;
+            case '\r':  entity = "&#13;";   break;
+            case '\t':  entity = "&#9;";    break;
+            default:                        break;
+        }
+
+        if (entity != nullptr)
+        {
+            mOutput.write (start, static_cast<size_t> (p - start));
+            writeRaw (entity);
+            start = p + 1;
+        }
+    }
+
+    writeRaw (start);
+}
+
+void XmlStreamWriter::writeAttributeName (juce::StringRef name)
+{
+    writeRaw (" ");
+    writeRaw (name.text.getAddress());
+    writeRaw ("=\"");
+}
+
+void XmlStreamWriter::writeNumberAttribute (juce::StringRef name, char* number)
+{
+    // snprintf follows the C locale, which may use a comma as decimal separator
+    for (auto p = number; *p != 0; ++p)
+    {
+        if (*p == ',')
+            *p = '.';
+    }
+
+    writeAttributeName (name);
+    writeRaw (number);
+    writeRaw ("\"");
+}
+
+//==============================================================================
+
+} // namespace state
+} // namespace grape
@@ -0,0 +1,81 @@
+/*
+    GRAPE is Romain's Audio Plug-in Extension classes for the JUCE framework
+
+    Copyright (c) 2018 Romain Clement
+
+    MIT License    
+    
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+    
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+ */
+
+//==============================================================================
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+
+namespace grape {
+namespace state {
+
+//==============================================================================
+
+class XmlStreamWriter
+{
+public:
+    XmlStreamWriter (size_t initialSize = 4096);
+    ~XmlStreamWriter();
+
+public:
+    void reset();
+
+    void writeHeader();
+    void startElement (juce::StringRef tagName);
+    void endElement (juce::StringRef tagName);
+
+    void writeAttribute (juce::StringRef name, juce::StringRef value);
+    void writeAttribute (juce::StringRef name, int value);
+    void writeAttribute (juce::StringRef name, juce::int64 value);
+    void writeAttribute (juce::StringRef name, float value);
+    void writeAttribute (juce::StringRef name, double value);
+    void writeVarAttribute (juce::StringRef name, const juce::var& value);
+
+    void writeValueTree (const juce::ValueTree&);
+
+    inline const void* getData() const { return mOutput.getData(); }
+    inline size_t getDataSize() const { return mOutput.getDataSize(); }
+
+private:
+    void writeRaw (const char* text);
+    void writeEscaped (const char* text);
+    void writeAttributeName (juce::StringRef name);
+    void writeNumberAttribute (juce::StringRef name, char* number);
+
+private:
+    juce::MemoryOutputStream    mOutput;
+    bool                        mStartTagOpen;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (XmlStreamWriter)
+};
+
+//==============================================================================
+
+} // namespace state
+} // namespace grape
@@ -0,0 +1,222 @@
+/*
+    GRAPE is Romain's Audio Plug-in Extension classes for the JUCE framework
+
+    Copyright (c) 2018 Romain Clement
+
+    MIT License    
+    
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+    
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+ */
+
+//==============================================================================
+
+#include "StressHarness.h"
+#include <grape/helpers/RealtimeGuard.h>
+
+//==============================================================================
+
+namespace grape {
+namespace stress {
+
+//==============================================================================
+
+const juce::String StressHarness::bankName ("GRAPE Stress");
+
+//==============================================================================
+
+StressHarness::StressHarness (const Options& options)
+    : mOptions (options)
+    , mProcessor (new host::TestProcessor (options.numParameters))
+    , mHost (new host::HeadlessHost (*mProcessor))
+    , mRandom (options.seed)
+    , mAutomationRandom (options.seed + 1)
+    , mReadChecksum (0.0f)
+{
+    mActionCounts.fill (0);
+
+    mBankFolder = mProcessor->getPresetManager().getUserPresetsLocation().getChildFile (bankName);
+    writePresets();
+
+    mProcessor->getStateInformation (mSession);
+    mHost->setBlockCallback ([this] (juce::int64 blockIndex) { automate (blockIndex); });
+}
+
+StressHarness::~StressHarness()
+{
+    mHost = nullptr;
+
+    // Pending saves finish before the preset manager goes away
+    mProcessor = nullptr;
+    mBankFolder.deleteRecursively();
+}
+
+//==============================================================================
+
+void StressHarness::run()
+{
+    helpers::RealtimeGuard::resetViolations();
+    mHost->startAudio();
+
+    const auto endTime = juce::Time::getMillisecondCounterHiRes() + mOptions.seconds * 1000.0;
+
+    while (juce::Time::getMillisecondCounterHiRes() < endTime)
+    {
+        perform (static_cast<Action> (mRandom.nextInt (numActions)));
+
+        // Lets asynchronous loads, saves and catalogue updates complete
+        host::HeadlessHost::dispatchMessages (mRandom.nextInt (3));
+    }
+
+    mHost->stopAudio();
+
+    // Settles loads that were still queued when audio stopped
+    host::HeadlessHost::dispatchMessages (100);
+}
+
+//==============================================================================
+
+juce::String StressHarness::createReport() const
+{
+    const auto formatHistogram = [] (const char* name, const helpers::LatencyHistogram& histogram)
+    {
+        return juce::String (name).paddedRight (' ', 20)
+            + " count " + juce::String (histogram.getCount())
+            + "  p50 " + juce::String (histogram.getPercentileMicroseconds (50.0), 1) + " us"
+            + "  p99 " + juce::String (histogram.getPercentileMicroseconds (99.0), 1) + " us"
+            + "  p99.9 " + juce::String (histogram.getPercentileMicroseconds (99.9), 1) + " us"
+            + "  max " + juce::String (histogram.getMaxMicroseconds(), 1) + " us\n";
+    };
+
+    juce::String report;
+    report << "Processed " << mHost->getNumProcessedBlocks() << " blocks of "
+           << mHost->getBlockSize() << " samples with " << mOptions.numParameters << " parameters\n"
+           << formatHistogram ("Parameter reads", mReadLatency)
+           << formatHistogram ("Automation", mAutomationLatency)
+           << "Message thread actions:\n";
+
+    for (int i = 0; i < numActions; ++i)
+        report << "  " << juce::String (getActionName (static_cast<Action> (i))).paddedRight (' ', 20)
+               << mActionCounts[static_cast<size_t> (i)] << "\n";
+
+    report << "Realtime violations: " << helpers::RealtimeGuard::getNumViolations() << "\n";
+    return report;
+}
+
+//==============================================================================
+
+const char* StressHarness::getActionName (Action action)
+{
+    switch (action)
+    {
+        case loadPreset:            return "loadPreset";
+        case loadPresetAsync:       return "loadPresetAsync";
+        case loadNextPreset:        return "loadNextPreset";
+        case loadPreviousPreset:    return "loadPreviousPreset";
+        case savePreset:            return "savePreset";
+        case savePresetAsync:       return "savePresetAsync";
+        case saveState:             return "saveState";
+        case restoreState:          return "restoreState";
+        case resetParameters:       return "resetParameters";
+        case changeSetting:         return "changeSetting";
+        case checkPresetChanged:    return "checkPresetChanged";
+        case refreshPresets:        return "refreshPresets";
+        case numActions:            break;
+    }
+
+    jassertfalse;
+    return "";
+}
+
+void StressHarness::writePresets()
+{
+    auto& parameters = mProcessor->getParameterManager();
+    auto& presets = mProcessor->getPresetManager();
+
+    for (int i = 0; i < mOptions.numPresets; ++i)
+    {
+        for (int p = 0; p < parameters.getNumParameters(); ++p)
+            parameters.getParameterByIndex (p)->setValueNotifyingHost (mRandom.nextFloat());
+
+        if (presets.saveCurrentPreset ("Stress " + juce::String (i + 1).paddedLeft ('0', 3), bankName, "GRAPE", juce::String()))
+            mPresets.add (presets.getCurrentPreset());
+    }
+
+    jassert (mPresets.size() == mOptions.numPresets);
+    parameters.resetAll();
+}
+
+void StressHarness::automate (juce::int64 blockIndex)
+{
+    GRAPE_SCOPED_AUDIO_THREAD;
+
+    auto& parameters = mProcessor->getParameterManager();
+    const auto numParameters = parameters.getNumParameters();
+
+    {
+        helpers::LatencyHistogram::ScopedMeasurement measurement (mAutomationLatency);
+
+        // A contiguous run of parameters, moving every block, as a host
+        // playing back several automation lanes would
+        const auto first = static_cast<int> ((blockIndex * mOptions.numAutomatedPerBlock) % numParameters);
+
+        for (int i = 0; i < juce::jmin (mOptions.numAutomatedPerBlock, numParameters); ++i)
+            parameters.getParameterByIndex ((first + i) % numParameters)->setValueNotifyingHost (mAutomationRandom.nextFloat());
+    }
+
+    {
+        helpers::LatencyHistogram::ScopedMeasurement measurement (mReadLatency);
+
+        auto checksum = 0.0f;
+        for (int i = 0; i < numParameters; ++i)
+            checksum += parameters.getParameterByIndex (i)->getValue();
+
+        mReadChecksum.store (checksum, std::memory_order_relaxed);
+    }
+}
+
+void StressHarness::perform (Action action)
+{
+    auto& presets = mProcessor->getPresetManager();
+    const auto& preset = mPresets.getReference (mRandom.nextInt (mPresets.size()));
+    const auto saveName = "Stress Save " + juce::String (mRandom.nextInt (4));
+
+    switch (action)
+    {
+        case loadPreset:            presets.loadPreset (preset); break;
+        case loadPresetAsync:       presets.loadPresetAsync (preset); break;
+        case loadNextPreset:        presets.loadNextPreset(); break;
+        case loadPreviousPreset:    presets.loadPreviousPreset(); break;
+        case savePreset:            presets.saveCurrentPreset (saveName, bankName, "GRAPE", juce::String()); break;
+        case savePresetAsync:       presets.saveCurrentPresetAsync (saveName, bankName, "GRAPE", juce::String()); break;
+        case saveState:             mProcessor->getStateInformation (mSession); break;
+        case restoreState:          mProcessor->setStateInformation (mSession.getData(), static_cast<int> (mSession.getSize())); break;
+        case resetParameters:       mProcessor->getParameterManager().resetAll(); break;
+        case changeSetting:         mProcessor->getSettingManager().setSetting ("oversampling", 1 << mRandom.nextInt (3)); break;
+        case checkPresetChanged:    presets.checkPresetChanged(); break;
+        case refreshPresets:        presets.refreshPresets(); break;
+        case numActions:            jassertfalse; return;
+    }
+
+    ++mActionCounts[static_cast<size_t> (action)];
+}
+
+//==============================================================================
+
+} // namespace stress
+} // namespace grape
@@ -0,0 +1,126 @@
+/*
+    GRAPE is Romain's Audio Plug-in Extension classes for the JUCE framework
+
+    Copyright (c) 2018 Romain Clement
+
+    MIT License    
+    
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+    
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+ */
+
+//==============================================================================
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <grape/helpers/LatencyHistogram.h>
+#include <grape/presets/Preset.h>
+#include "HeadlessHost.h"
+#include "TestProcessor.h"
+#include <array>
+#include <atomic>
+#include <memory>
+
+//==============================================================================
+
+namespace grape {
+namespace stress {
+
+//==============================================================================
+
+/** Runs host automation on a paced audio thread while the message thread
+    loads, saves and navigates presets, resets parameters, changes settings
+    and saves and restores the processor state, all at random.
+
+    The time the audio thread takes to read every parameter, and to automate
+    its share of them, is recorded into latency histograms. Build with
+    GRAPE_ENABLE_TSAN to have ThreadSanitizer check the same run for races.
+*/
+class StressHarness
+{
+public:
+    struct Options
+    {
+        double      seconds = 10.0;
+        int         numParameters = 64;
+        int         numPresets = 32;
+        int         numAutomatedPerBlock = 16;
+        juce::int64 seed = 1;
+    };
+
+    enum Action
+    {
+        loadPreset = 0,
+        loadPresetAsync,
+        loadNextPreset,
+        loadPreviousPreset,
+        savePreset,
+        savePresetAsync,
+        saveState,
+        restoreState,
+        resetParameters,
+        changeSetting,
+        checkPresetChanged,
+        refreshPresets,
+        numActions
+    };
+
+public:
+    explicit StressHarness (const Options&);
+    ~StressHarness();
+
+public:
+    static const juce::String bankName;
+
+    void run();
+
+    inline const helpers::LatencyHistogram& getReadLatency() const { return mReadLatency; }
+    inline const helpers::LatencyHistogram& getAutomationLatency() const { return mAutomationLatency; }
+    inline juce::int64 getNumProcessedBlocks() const { return mHost->getNumProcessedBlocks(); }
+
+    juce::String createReport() const;
+
+private:
+    static const char* getActionName (Action);
+
+    void writePresets();
+    void automate (juce::int64 blockIndex);
+    void perform (Action);
+
+private:
+    const Options                           mOptions;
+    std::unique_ptr<host::TestProcessor>    mProcessor;
+    std::unique_ptr<host::HeadlessHost>     mHost;
+    juce::File                              mBankFolder;
+    juce::Array<presets::Preset>            mPresets;
+    juce::MemoryBlock                       mSession;
+    juce::Random                            mRandom;
+    juce::Random                            mAutomationRandom;
+    std::atomic<float>                      mReadChecksum;
+    helpers::LatencyHistogram               mReadLatency;
+    helpers::LatencyHistogram               mAutomationLatency;
+    std::array<int, numActions>             mActionCounts;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (StressHarness)
+};
+
+//==============================================================================
+
+} // namespace stress
+} // namespace grape
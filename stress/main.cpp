@@ -0,0 +1,113 @@
+/*
+    GRAPE is Romain's Audio Plug-in Extension classes for the JUCE framework
+
+    Copyright (c) 2018 Romain Clement
+
+    MIT License    
+    
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+    
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+ */
+
+//==============================================================================
+
+#include <JuceHeader.h>
+#include <grape/helpers/RealtimeGuard.h>
+#include "StressHarness.h"
+#include <iostream>
+
+//==============================================================================
+
+static void printUsage()
+{
+    std::cerr << "Usage: grape_stress [--seconds <n>] [--parameters <n>] [--presets <n>] [--seed <n>] [--max-read-us <n>]" << std::endl
+              << std::endl
+              << "  --seconds <n>       Duration of the run (default 10)" << std::endl
+              << "  --parameters <n>    Number of processor parameters (default 64)" << std::endl
+              << "  --presets <n>       Number of presets to load from (default 32)" << std::endl
+              << "  --seed <n>          Seed for the random actions and automation" << std::endl
+              << "  --max-read-us <n>   Fail if reading the parameters ever took longer" << std::endl;
+}
+
+int main (int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    grape::stress::StressHarness::Options options;
+    auto maxReadMicroseconds = 0.0;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const juce::String arg (argv[i]);
+        const juce::String value (i + 1 < argc ? argv[i + 1] : "");
+
+        if (value.isEmpty())
+        {
+            printUsage();
+            return 1;
+        }
+
+        if (arg == "--seconds")
+            options.seconds = value.getDoubleValue();
+        else if (arg == "--parameters")
+            options.numParameters = juce::jmax (1, value.getIntValue());
+        else if (arg == "--presets")
+            options.numPresets = juce::jmax (1, value.getIntValue());
+        else if (arg == "--seed")
+            options.seed = value.getLargeIntValue();
+        else if (arg == "--max-read-us")
+            maxReadMicroseconds = value.getDoubleValue();
+        else
+        {
+            printUsage();
+            return 1;
+        }
+
+        ++i;
+    }
+
+    auto failed = false;
+
+    {
+        grape::stress::StressHarness harness (options);
+        harness.run();
+
+        std::cout << harness.createReport();
+
+        if (harness.getNumProcessedBlocks() == 0)
+        {
+            std::cerr << "FAILED: the audio thread processed no blocks" << std::endl;
+            failed = true;
+        }
+
+        if (maxReadMicroseconds > 0.0 && harness.getReadLatency().getMaxMicroseconds() > maxReadMicroseconds)
+        {
+            std::cerr << "FAILED: parameter reads took up to " << harness.getReadLatency().getMaxMicroseconds()
+                      << " us, above the " << maxReadMicroseconds << " us limit" << std::endl;
+            failed = true;
+        }
+    }
+
+    if (grape::helpers::RealtimeGuard::getNumViolations() > 0)
+    {
+        std::cerr << "FAILED: non-realtime calls or locks on the audio thread" << std::endl;
+        failed = true;
+    }
+
+    return failed ? 1 : 0;
+}
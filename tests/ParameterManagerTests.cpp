@@ -0,0 +1,147 @@
+/*
+    GRAPE is Romain's Audio Plug-in Extension classes for the JUCE framework
+
+    Copyright (c) 2018 Romain Clement
+
+    MIT License    
+    
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+    
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+ */
+
+//==============================================================================
+
+#include <JuceHeader.h>
+#include <grape/state/XmlStreamReader.h>
+#include <grape/state/XmlStreamWriter.h>
+#include "TestProcessor.h"
+
+//==============================================================================
+
+namespace grape {
+namespace parameters {
+
+//==============================================================================
+
+class ParameterManagerTests : public juce::UnitTest
+{
+public:
+    ParameterManagerTests()
+        : juce::UnitTest ("ParameterManager", "grape")
+    {
+
+    }
+
+    void runTest() override
+    {
+        beginTest ("Streamed XML keeps values, properties and extra children");
+        {
+            host::TestProcessor source;
+            auto& parameters = source.getParameterManager();
+
+            parameters.getParameterByIndex (0)->setValueNotifyingHost (0.25f);
+            parameters.getParameterByIndex (3)->setValueNotifyingHost (0.75f);
+            parameters.state.setProperty ("version", 3, nullptr);
+            parameters.state.appendChild (juce::ValueTree ("EXTRA").setProperty ("name", "kept", nullptr), nullptr);
+
+            state::XmlStreamWriter writer;
+            parameters.writeXml (writer);
+
+            host::TestProcessor destination;
+            auto& restored = destination.getParameterManager();
+            restored.state.setProperty ("stale", true, nullptr);
+
+            state::XmlStreamReader reader (writer.getData(), writer.getDataSize());
+            expect (reader.next() == state::XmlStreamReader::startElement);
+            expect (restored.readXml (reader));
+
+            expectWithinAbsoluteError (restored.getParameterByIndex (0)->getValue(), 0.25f, 1.0e-6f);
+            expectWithinAbsoluteError (restored.getParameterByIndex (3)->getValue(), 0.75f, 1.0e-6f);
+            expectEquals (static_cast<int> (restored.state.getProperty ("version")), 3);
+            expect (!restored.state.hasProperty ("stale"));
+            expectEquals (restored.state.getChildWithName ("EXTRA").getProperty ("name").toString(), juce::String ("kept"));
+        }
+
+        beginTest ("Binary stream keeps values, properties and extra children");
+        {
+            host::TestProcessor source;
+            auto& parameters = source.getParameterManager();
+
+            parameters.getParameterByIndex (1)->setValueNotifyingHost (0.6f);
+            parameters.state.setProperty ("version", 3, nullptr);
+            parameters.state.appendChild (juce::ValueTree ("EXTRA").setProperty ("name", "kept", nullptr), nullptr);
+
+            juce::MemoryOutputStream output;
+            parameters.writeToStream (output);
+
+            host::TestProcessor destination;
+            auto& restored = destination.getParameterManager();
+            restored.state.setProperty ("stale", true, nullptr);
+
+            juce::MemoryInputStream input (output.getData(), output.getDataSize(), false);
+            expect (restored.readFromStream (input));
+
+            expectWithinAbsoluteError (restored.getParameterByIndex (1)->getValue(), 0.6f, 1.0e-6f);
+            expectEquals (static_cast<int> (restored.state.getProperty ("version")), 3);
+            expect (!restored.state.hasProperty ("stale"));
+            expectEquals (restored.state.getChildWithName ("EXTRA").getProperty ("name").toString(), juce::String ("kept"));
+        }
+
+        beginTest ("Truncated binary stream changes nothing");
+        {
+            host::TestProcessor source;
+            source.getParameterManager().getParameterByIndex (1)->setValueNotifyingHost (0.6f);
+
+            juce::MemoryOutputStream output;
+            source.getParameterManager().writeToStream (output);
+
+            host::TestProcessor destination;
+            auto& restored = destination.getParameterManager();
+            const auto before = restored.getParameterByIndex (1)->getValue();
+
+            // Cut off inside the list of values
+            juce::MemoryInputStream input (output.getData(), 6, false);
+            expect (!restored.readFromStream (input));
+            expectEquals (restored.getParameterByIndex (1)->getValue(), before);
+        }
+
+        beginTest ("State comparison tolerates rounding of stored values");
+        {
+            host::TestProcessor processor;
+            auto& parameters = processor.getParameterManager();
+            auto* frequency = parameters.getParameterByIndex (1);
+
+            frequency->setValueNotifyingHost (0.5f);
+            const auto reference = parameters.copyState();
+            expect (parameters.matchesState (reference));
+
+            frequency->setValueNotifyingHost (0.5f + 1.0e-6f);
+            expect (parameters.matchesState (reference));
+
+            frequency->setValueNotifyingHost (0.6f);
+            expect (!parameters.matchesState (reference));
+        }
+    }
+};
+
+static ParameterManagerTests parameterManagerTests;
+
+//==============================================================================
+
+} // namespace parameters
+} // namespace grape
@@ -0,0 +1,173 @@
+/*
+    GRAPE is Romain's Audio Plug-in Extension classes for the JUCE framework
+
+    Copyright (c) 2018 Romain Clement
+
+    MIT License    
+    
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+    
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+ */
+
+//==============================================================================
+
+#include <JuceHeader.h>
+#include <grape/helpers/RealtimeGuard.h>
+#include "HeadlessHost.h"
+#include "TestProcessor.h"
+
+//==============================================================================
+
+namespace grape {
+namespace presets {
+
+//==============================================================================
+
+struct HostNotifications : public juce::AudioProcessorListener
+{
+    void audioProcessorParameterChanged (juce::AudioProcessor*, int, float) override { ++numChanges; }
+    void audioProcessorChanged (juce::AudioProcessor*) override {}
+    void audioProcessorParameterChangeGestureBegin (juce::AudioProcessor*, int) override { ++numGesturesBegun; }
+    void audioProcessorParameterChangeGestureEnd (juce::AudioProcessor*, int) override { ++numGesturesEnded; }
+
+    int numChanges = 0;
+    int numGesturesBegun = 0;
+    int numGesturesEnded = 0;
+};
+
+//==============================================================================
+
+class PresetManagerTests : public juce::UnitTest
+{
+public:
+    PresetManagerTests()
+        : juce::UnitTest ("PresetManager", "grape")
+    {
+
+    }
+
+    void runTest() override
+    {
+        host::TestProcessor processor;
+        auto& presets = processor.getPresetManager();
+        auto* gain = processor.getParameterManager().getParameterByIndex (0);
+
+        const auto isCurrent = [&presets] (const juce::String& name)
+        {
+            return [&presets, name] { return presets.getCurrentPreset().getName() == name; };
+        };
+
+        beginTest ("Saves user presets and loads them back");
+
+        gain->setValueNotifyingHost (0.2f);
+        expect (presets.saveCurrentPreset ("Low", "GRAPE Tests", "GRAPE", juce::String()));
+        const auto low = presets.getCurrentPreset();
+        expectEquals (low.getName(), juce::String ("Low"));
+        expect (low.getFile().existsAsFile());
+
+        gain->setValueNotifyingHost (0.8f);
+        expect (presets.saveCurrentPreset ("High", "GRAPE Tests", "GRAPE", juce::String()));
+        const auto high = presets.getCurrentPreset();
+
+        presets.loadPreset (low);
+        expectEquals (presets.getCurrentPreset().getName(), juce::String ("Low"));
+        expectWithinAbsoluteError (gain->getValue(), 0.2f, 1.0e-4f);
+
+        presets.loadPreset (high);
+        expectEquals (presets.getCurrentPreset().getName(), juce::String ("High"));
+        expectWithinAbsoluteError (gain->getValue(), 0.8f, 1.0e-4f);
+
+        beginTest ("Navigates between presets in a stable order");
+
+        presets.setNavigationOrder ({ PresetNavigator::sortByBank, PresetNavigator::sortByName }, false);
+        expect (presets.getNumNavigablePresets() >= 2);
+        expect (presets.getCurrentPresetPosition() >= 0);
+
+        presets.loadNextPreset();
+        expect (isCurrent ("Low")());
+        expectWithinAbsoluteError (gain->getValue(), 0.2f, 1.0e-4f);
+
+        presets.loadPreviousPreset();
+        expect (isCurrent ("High")());
+        expectWithinAbsoluteError (gain->getValue(), 0.8f, 1.0e-4f);
+
+        beginTest ("Async saves keep a newer selection");
+        {
+            auto saveFinished = false;
+            presets.saveCurrentPresetAsync ("Later", "GRAPE Tests", "GRAPE", juce::String(), {},
+                                            [&saveFinished] (bool) { saveFinished = true; });
+            presets.loadPreset (low);
+
+            expect (host::HeadlessHost::dispatchMessagesUntil ([&saveFinished] { return saveFinished; }, 5000));
+            expect (isCurrent ("Low")());
+
+            const auto later = presets.getUserPreset ("Later", "GRAPE Tests");
+            expect (later.getFile().existsAsFile());
+            later.getFile().deleteFile();
+
+            presets.loadPreset (high);
+        }
+
+        beginTest ("Loads presets through the audio thread");
+        {
+            host::HeadlessHost host (processor);
+            helpers::RealtimeGuard::resetViolations();
+
+            host.startAudio();
+            expect (host::HeadlessHost::dispatchMessagesUntil ([&host] { return host.getNumProcessedBlocks() > 2; }, 2000));
+
+            HostNotifications notifications;
+            processor.addListener (&notifications);
+
+            presets.loadPresetAsync (low);
+            expect (host::HeadlessHost::dispatchMessagesUntil (isCurrent ("Low"), 5000));
+            expectWithinAbsoluteError (gain->getValue(), 0.2f, 1.0e-4f);
+
+            // The ramped values reach the host and the parameter listeners
+            processor.removeListener (&notifications);
+            expect (notifications.numChanges > 0);
+            expect (notifications.numGesturesBegun > 0);
+            expectEquals (notifications.numGesturesEnded, notifications.numGesturesBegun);
+
+            const auto rawGain = static_cast<float> (*processor.getParameterManager().getRawParameterValue ("param0"));
+            expectWithinAbsoluteError (rawGain, 0.4f, 1.0e-4f);
+
+            host.stopAudio();
+            expectEquals (helpers::RealtimeGuard::getNumViolations(), 0);
+
+            beginTest ("Falls back to a synchronous load when audio stops");
+
+            // The audio thread looks active for a moment, then never drains the queue
+            host.processBlocks (1);
+            presets.loadPresetAsync (high);
+            expect (host::HeadlessHost::dispatchMessagesUntil (isCurrent ("High"), 5000));
+            expectWithinAbsoluteError (gain->getValue(), 0.8f, 1.0e-4f);
+        }
+
+        low.getFile().deleteFile();
+        high.getFile().deleteFile();
+        presets.refreshPresets();
+    }
+};
+
+static PresetManagerTests presetManagerTests;
+
+//==============================================================================
+
+} // namespace presets
+} // namespace grape
@@ -0,0 +1,108 @@
+/*
+    GRAPE is Romain's Audio Plug-in Extension classes for the JUCE framework
+
+    Copyright (c) 2018 Romain Clement
+
+    MIT License    
+    
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+    
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+ */
+
+//==============================================================================
+
+#include <JuceHeader.h>
+#include "TestProcessor.h"
+
+//==============================================================================
+
+namespace grape {
+namespace state {
+
+//==============================================================================
+
+class StateChunkTests : public juce::UnitTest
+{
+public:
+    StateChunkTests()
+        : juce::UnitTest ("StateChunk", "grape")
+    {
+
+    }
+
+    void runTest() override
+    {
+        for (auto compressed : { false, true })
+        {
+            beginTest (compressed ? "Compressed round trip" : "Uncompressed round trip");
+
+            host::TestProcessor source;
+            source.getParameterManager().getParameterByIndex (0)->setValueNotifyingHost (0.125f);
+            source.getParameterManager().getParameterByIndex (2)->setValueNotifyingHost (1.0f);
+            source.getSettingManager().setSetting ("theme", "light");
+
+            juce::MemoryBlock data;
+            StateChunk chunk (&source.getParameterManager(), &source.getSettingManager(), &source.getPresetManager());
+            chunk.setCompressionEnabled (compressed);
+            chunk.save (data);
+
+            host::TestProcessor destination;
+            destination.setStateInformation (data.getData(), static_cast<int> (data.getSize()));
+
+            expectWithinAbsoluteError (destination.getParameterManager().getParameterByIndex (0)->getValue(), 0.125f, 1.0e-6f);
+            expectEquals (destination.getParameterManager().getParameterByIndex (2)->getValue(), 1.0f);
+            expectEquals (destination.getSettingManager().getSetting ("theme").toString(), juce::String ("light"));
+        }
+
+        beginTest ("Rejects malformed chunks");
+        {
+            host::TestProcessor processor;
+            StateChunk chunk (&processor.getParameterManager());
+
+            juce::MemoryBlock valid;
+            chunk.save (valid);
+
+            // Truncated payload
+            expect (!chunk.load (valid.getData(), static_cast<int> (valid.getSize()) - 1));
+
+            // Declared payload sizes that are negative or absurdly large are
+            // refused before anything is allocated
+            for (auto compressed : { false, true })
+            {
+                for (auto payloadSize : { static_cast<juce::int64> (-1), static_cast<juce::int64> (1) << 40 })
+                {
+                    juce::MemoryOutputStream output;
+                    output.writeInt (0x45505247); // 'GRPE'
+                    output.writeInt (StateChunk::formatVersion);
+                    output.writeInt (compressed ? 1 : 0);
+                    output.writeInt64 (payloadSize);
+                    output.writeInt (0);
+
+                    expect (!chunk.load (output.getData(), static_cast<int> (output.getDataSize())));
+                }
+            }
+        }
+    }
+};
+
+static StateChunkTests stateChunkTests;
+
+//==============================================================================
+
+} // namespace state
+} // namespace grape
@@ -0,0 +1,92 @@
+/*
+    GRAPE is Romain's Audio Plug-in Extension classes for the JUCE framework
+
+    Copyright (c) 2018 Romain Clement
+
+    MIT License    
+    
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+    
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+ */
+
+//==============================================================================
+
+#include <JuceHeader.h>
+#include <grape/helpers/ValueFormatter.h>
+
+//==============================================================================
+
+namespace grape {
+namespace helpers {
+
+//==============================================================================
+
+class ValueFormatterTests : public juce::UnitTest
+{
+public:
+    ValueFormatterTests()
+        : juce::UnitTest ("ValueFormatter", "grape")
+    {
+
+    }
+
+    void runTest() override
+    {
+        const ValueFormat linear { 2, ValueScaling::linear, "" };
+        const ValueFormat gain { 1, ValueScaling::gainToDecibels, " dB" };
+        const ValueFormat frequency { 1, ValueScaling::frequency, " Hz" };
+        const ValueFormat time { 0, ValueScaling::secondsToMilliseconds, " ms" };
+
+        beginTest ("Formats values with scaling and units");
+
+        expectEquals (formatValue (0.5f, linear).toString(), juce::String ("0.50"));
+        expectEquals (formatValue (-0.001f, linear).toString(), juce::String ("0.00"));
+        expectEquals (formatValue (1.0f, gain).toString(), juce::String ("0.0 dB"));
+        expectEquals (formatValue (0.0f, gain).toString(), juce::String ("-inf dB"));
+        expectEquals (formatValue (440.0f, frequency).toString(), juce::String ("440.0 Hz"));
+        expectEquals (formatValue (2500.0f, frequency).toString(), juce::String ("2.5 kHz"));
+        expectEquals (formatValue (0.25f, time).toString(), juce::String ("250 ms"));
+
+        beginTest ("Parses formatted text back");
+
+        expectWithinAbsoluteError (parseValue ("0.50", linear), 0.5f, 1.0e-6f);
+        expectWithinAbsoluteError (parseValue ("0.0 dB", gain), 1.0f, 1.0e-6f);
+        expectEquals (parseValue ("-inf dB", gain), 0.0f);
+        expectWithinAbsoluteError (parseValue ("2.5 kHz", frequency), 2500.0f, 1.0e-3f);
+        expectWithinAbsoluteError (parseValue ("250 ms", time), 0.25f, 1.0e-6f);
+
+        beginTest ("Only frequencies take a kilo prefix");
+
+        expectWithinAbsoluteError (parseValue ("5k", frequency), 5000.0f, 1.0e-3f);
+        expectWithinAbsoluteError (parseValue ("5k", linear), 5.0f, 1.0e-6f);
+        expectWithinAbsoluteError (parseValue ("5 k", gain), juce::Decibels::decibelsToGain (5.0f), 1.0e-5f);
+
+        beginTest ("Rejects text without a number");
+
+        auto result = 1.0f;
+        expect (!parseValue (juce::String ("abc").getCharPointer(), linear, result));
+        expectEquals (result, 1.0f);
+    }
+};
+
+static ValueFormatterTests valueFormatterTests;
+
+//==============================================================================
+
+} // namespace helpers
+} // namespace grape
@@ -0,0 +1,143 @@
+/*
+    GRAPE is Romain's Audio Plug-in Extension classes for the JUCE framework
+
+    Copyright (c) 2018 Romain Clement
+
+    MIT License    
+    
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+    
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+ */
+
+//==============================================================================
+
+#include "HeadlessHost.h"
+
+//==============================================================================
+
+namespace grape {
+namespace host {
+
+//==============================================================================
+
+static const int numChannels = 2;
+static const int stopTimeoutMilliseconds = 2000;
+
+//==============================================================================
+
+HeadlessHost::HeadlessHost (juce::AudioProcessor& processor, double sampleRate, int blockSize)
+    : juce::Thread ("GRAPE headless audio")
+    , mProcessor (processor)
+    , mSampleRate (sampleRate)
+    , mBlockSize (blockSize)
+    , mBuffer (numChannels, blockSize)
+    , mNumProcessedBlocks (0)
+{
+    mMidi.ensureSize (256);
+
+    mProcessor.setPlayConfigDetails (numChannels, numChannels, mSampleRate, mBlockSize);
+    mProcessor.prepareToPlay (mSampleRate, mBlockSize);
+}
+
+HeadlessHost::~HeadlessHost()
+{
+    stopAudio();
+    mProcessor.releaseResources();
+}
+
+//==============================================================================
+
+void HeadlessHost::processBlocks (int numBlocks)
+{
+    jassert (!isAudioRunning());
+
+    for (int i = 0; i < numBlocks; ++i)
+        processBlock();
+}
+
+void HeadlessHost::startAudio()
+{
+    if (!isAudioRunning())
+        startThread (8);
+}
+
+void HeadlessHost::stopAudio()
+{
+    stopThread (stopTimeoutMilliseconds);
+}
+
+//==============================================================================
+
+bool HeadlessHost::dispatchMessagesUntil (std::function<bool()> condition, int timeoutMilliseconds)
+{
+    const auto endTime = juce::Time::getMillisecondCounter() + static_cast<juce::uint32> (timeoutMilliseconds);
+
+    while (!condition())
+    {
+        if (juce::Time::getMillisecondCounter() >= endTime)
+            return condition();
+
+        juce::MessageManager::getInstance()->runDispatchLoopUntil (1);
+    }
+
+    return true;
+}
+
+void HeadlessHost::dispatchMessages (int milliseconds)
+{
+    juce::MessageManager::getInstance()->runDispatchLoopUntil (milliseconds);
+}
+
+//==============================================================================
+
+void HeadlessHost::run()
+{
+    const auto blockMilliseconds = 1000.0 * mBlockSize / mSampleRate;
+    auto nextBlockTime = juce::Time::getMillisecondCounterHiRes();
+
+    while (!threadShouldExit())
+    {
+        processBlock();
+
+        nextBlockTime += blockMilliseconds;
+        const auto delay = nextBlockTime - juce::Time::getMillisecondCounterHiRes();
+
+        if (delay >= 1.0)
+            wait (static_cast<int> (delay));
+        else if (delay < -100.0 * blockMilliseconds)
+            nextBlockTime = juce::Time::getMillisecondCounterHiRes(); // fell far behind, don't catch up
+    }
+}
+
+void HeadlessHost::processBlock()
+{
+    const auto blockIndex = mNumProcessedBlocks.load();
+
+    if (mBlockCallback != nullptr)
+        mBlockCallback (blockIndex);
+
+    mMidi.clear();
+    mProcessor.processBlock (mBuffer, mMidi);
+
+    mNumProcessedBlocks = blockIndex + 1;
+}
+
+//==============================================================================
+
+} // namespace host
+} // namespace grape
@@ -0,0 +1,100 @@
+/*
+    GRAPE is Romain's Audio Plug-in Extension classes for the JUCE framework
+
+    Copyright (c) 2018 Romain Clement
+
+    MIT License    
+    
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+    
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+ */
+
+//==============================================================================
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <atomic>
+#include <functional>
+
+//==============================================================================
+
+namespace grape {
+namespace host {
+
+//==============================================================================
+
+/** Drives an AudioProcessor without audio devices or windows.
+
+    Blocks are either processed synchronously on the calling thread, or by a
+    dedicated audio thread paced at the block duration. The two must not be
+    mixed: processBlocks() is only allowed while the audio thread is stopped.
+*/
+class HeadlessHost : private juce::Thread
+{
+public:
+    using BlockCallback = std::function<void (juce::int64 blockIndex)>;
+
+public:
+    HeadlessHost (juce::AudioProcessor&, double sampleRate = 48000.0, int blockSize = 256);
+    ~HeadlessHost();
+
+public:
+    inline double getSampleRate() const { return mSampleRate; }
+    inline int getBlockSize() const { return mBlockSize; }
+    inline juce::int64 getNumProcessedBlocks() const { return mNumProcessedBlocks.load(); }
+
+    /** Called on the processing thread before each block, e.g. to automate
+        parameters the way a host would. Set it while audio is stopped.
+    */
+    inline void setBlockCallback (BlockCallback callback) { mBlockCallback = callback; }
+
+    void processBlocks (int numBlocks);
+
+    void startAudio();
+    void stopAudio();
+    inline bool isAudioRunning() const { return isThreadRunning(); }
+
+    /** Runs the message loop until condition returns true or the timeout
+        expires. Returns the last result of condition.
+    */
+    static bool dispatchMessagesUntil (std::function<bool()> condition, int timeoutMilliseconds);
+    static void dispatchMessages (int milliseconds);
+
+private: // juce::Thread
+    void run() override;
+
+private:
+    void processBlock();
+
+private:
+    juce::AudioProcessor&       mProcessor;
+    const double                mSampleRate;
+    const int                   mBlockSize;
+    juce::AudioBuffer<float>    mBuffer;
+    juce::MidiBuffer            mMidi;
+    BlockCallback               mBlockCallback;
+    std::atomic<juce::int64>    mNumProcessedBlocks;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (HeadlessHost)
+};
+
+//==============================================================================
+
+} // namespace host
+} // namespace grape
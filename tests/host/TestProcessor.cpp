@@ -0,0 +1,208 @@
+/*
+    GRAPE is Romain's Audio Plug-in Extension classes for the JUCE framework
+
+    Copyright (c) 2018 Romain Clement
+
+    MIT License    
+    
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+    
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+ */
+
+//==============================================================================
+
+#include "TestProcessor.h"
+#include <grape/helpers/ValueFormatter.h>
+#include <grape/helpers/RealtimeGuard.h>
+
+//==============================================================================
+
+namespace grape {
+namespace host {
+
+//==============================================================================
+
+constexpr int TestProcessor::defaultNumParameters;
+
+//==============================================================================
+
+TestProcessor::TestProcessor (int numParameters)
+    : mParameterManager (*this, &mUndoManager, createParameters (numParameters))
+    , mSettingManager (createSettings(), &mUndoManager)
+    , mPresetManager (mParameterManager)
+    , mStateChunk (&mParameterManager, &mSettingManager, &mPresetManager)
+{
+
+}
+
+TestProcessor::~TestProcessor()
+{
+
+}
+
+//==============================================================================
+
+std::vector<parameters::Parameter> TestProcessor::createParameters (int numParameters)
+{
+    static const helpers::ValueFormat gainFormat { 1, helpers::ValueScaling::gainToDecibels, " dB" };
+    static const helpers::ValueFormat frequencyFormat { 1, helpers::ValueScaling::frequency, " Hz" };
+    static const helpers::ValueFormat linearFormat { 2, helpers::ValueScaling::linear, "" };
+
+    std::vector<parameters::Parameter> params;
+    params.reserve (static_cast<size_t> (numParameters));
+
+    // Cycle through the kinds of parameters a typical plug-in exposes
+    for (int i = 0; i < numParameters; ++i)
+    {
+        parameters::Parameter param;
+        param.id = "param" + juce::String (i);
+        param.name = "Parameter " + juce::String (i);
+
+        switch (i % 4)
+        {
+            case 0:
+                param.valueRange = juce::NormalisableRange<float> (0.0f, 2.0f);
+                param.defaultValue = 1.0f;
+                param.valueToTextFunction = helpers::makeValueToTextFunction (gainFormat);
+                param.textToValueFunction = helpers::makeTextToValueFunction (gainFormat);
+                break;
+
+            case 1:
+                param.valueRange = juce::NormalisableRange<float> (20.0f, 20000.0f, 0.0f, 0.25f);
+                param.defaultValue = 1000.0f;
+                param.valueToTextFunction = helpers::makeValueToTextFunction (frequencyFormat);
+                param.textToValueFunction = helpers::makeTextToValueFunction (frequencyFormat);
+                break;
+
+            case 2:
+                param.valueRange = juce::NormalisableRange<float> (0.0f, 3.0f, 1.0f);
+                param.defaultValue = 0.0f;
+                param.isDiscrete = true;
+                break;
+
+            default:
+                param.valueRange = juce::NormalisableRange<float> (-1.0f, 1.0f);
+                param.defaultValue = 0.0f;
+                param.valueToTextFunction = helpers::makeValueToTextFunction (linearFormat);
+                param.textToValueFunction = helpers::makeTextToValueFunction (linearFormat);
+                break;
+        }
+
+        params.push_back (param);
+    }
+
+    return params;
+}
+
+std::vector<settings::Setting> TestProcessor::createSettings()
+{
+    return {
+        { "oversampling", "Oversampling", 1, nullptr, nullptr },
+        { "theme", "Theme", "dark", nullptr, nullptr }
+    };
+}
+
+//==============================================================================
+
+const juce::String TestProcessor::getName() const
+{
+    return "GRAPE Test Processor";
+}
+
+void TestProcessor::prepareToPlay (double, int)
+{
+
+}
+
+void TestProcessor::releaseResources()
+{
+
+}
+
+void TestProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer&)
+{
+    GRAPE_SCOPED_AUDIO_THREAD;
+
+    mPresetManager.processPendingLoads (buffer.getNumSamples());
+    buffer.clear();
+}
+
+double TestProcessor::getTailLengthSeconds() const
+{
+    return 0.0;
+}
+
+bool TestProcessor::acceptsMidi() const
+{
+    return false;
+}
+
+bool TestProcessor::producesMidi() const
+{
+    return false;
+}
+
+juce::AudioProcessorEditor* TestProcessor::createEditor()
+{
+    return nullptr;
+}
+
+bool TestProcessor::hasEditor() const
+{
+    return false;
+}
+
+int TestProcessor::getNumPrograms()
+{
+    return 1;
+}
+
+int TestProcessor::getCurrentProgram()
+{
+    return 0;
+}
+
+void TestProcessor::setCurrentProgram (int)
+{
+
+}
+
+const juce::String TestProcessor::getProgramName (int)
+{
+    return juce::String();
+}
+
+void TestProcessor::changeProgramName (int, const juce::String&)
+{
+
+}
+
+void TestProcessor::getStateInformation (juce::MemoryBlock& destData)
+{
+    mStateChunk.save (destData);
+}
+
+void TestProcessor::setStateInformation (const void* data, int sizeInBytes)
+{
+    mStateChunk.load (data, sizeInBytes);
+}
+
+//==============================================================================
+
+} // namespace host
+} // namespace grape
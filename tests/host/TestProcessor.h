@@ -0,0 +1,100 @@
+/*
+    GRAPE is Romain's Audio Plug-in Extension classes for the JUCE framework
+
+    Copyright (c) 2018 Romain Clement
+
+    MIT License    
+    
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+    
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+ */
+
+//==============================================================================
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <grape/parameters/ParameterManager.h>
+#include <grape/settings/SettingManager.h>
+#include <grape/presets/PresetManager.h>
+#include <grape/state/StateChunk.h>
+#include <vector>
+
+//==============================================================================
+
+namespace grape {
+namespace host {
+
+//==============================================================================
+
+/** A minimal plug-in wiring the GRAPE managers together the way a real
+    processor would, for tests, benchmarks and the stress harness.
+*/
+class TestProcessor : public juce::AudioProcessor
+{
+public:
+    explicit TestProcessor (int numParameters = defaultNumParameters);
+    ~TestProcessor();
+
+public:
+    static constexpr int defaultNumParameters = 8;
+
+    static std::vector<parameters::Parameter> createParameters (int numParameters);
+    static std::vector<settings::Setting> createSettings();
+
+    inline parameters::ParameterManager& getParameterManager() { return mParameterManager; }
+    inline settings::SettingManager& getSettingManager() { return mSettingManager; }
+    inline presets::PresetManager& getPresetManager() { return mPresetManager; }
+
+public: // juce::AudioProcessor
+    const juce::String getName() const override;
+
+    void prepareToPlay (double sampleRate, int maximumExpectedSamplesPerBlock) override;
+    void releaseResources() override;
+    void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+
+    double getTailLengthSeconds() const override;
+    bool acceptsMidi() const override;
+    bool producesMidi() const override;
+
+    juce::AudioProcessorEditor* createEditor() override;
+    bool hasEditor() const override;
+
+    int getNumPrograms() override;
+    int getCurrentProgram() override;
+    void setCurrentProgram (int index) override;
+    const juce::String getProgramName (int index) override;
+    void changeProgramName (int index, const juce::String& newName) override;
+
+    void getStateInformation (juce::MemoryBlock& destData) override;
+    void setStateInformation (const void* data, int sizeInBytes) override;
+
+private:
+    juce::UndoManager               mUndoManager;
+    parameters::ParameterManager    mParameterManager;
+    settings::SettingManager        mSettingManager;
+    presets::PresetManager          mPresetManager;
+    state::StateChunk               mStateChunk;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TestProcessor)
+};
+
+//==============================================================================
+
+} // namespace host
+} // namespace grape
@@ -0,0 +1,171 @@
+/*
+    GRAPE is Romain's Audio Plug-in Extension classes for the JUCE framework
+
+    Copyright (c) 2018 Romain Clement
+
+    MIT License    
+    
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+    
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+    
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+ */
+
+//==============================================================================
+
+/*  Compiles a folder of factory presets into a C++ source file holding a
+    zlib-compressed blob and a constexpr table of contents, for use with
+    grape::presets::EmbeddedPresets.
+
+    Usage: PresetPacker <presets folder> <output.cpp>
+
+    Link the generated file into the plug-in and build grape with
+    GRAPE_EMBEDDED_PRESETS=1.
+*/
+
+#include <JuceHeader.h>
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+//==============================================================================
+
+static juce::String toCppStringLiteral (const juce::String& text)
+{
+    juce::String literal ("\"");
+
+    for (auto c = text.toRawUTF8(); *c != 0; ++c)
+    {
+        const auto byte = static_cast<unsigned char> (*c);
+
+        if (byte == '"' || byte == '\\')
+            literal << "\\" << juce::String::charToString (byte);
+        else if (byte < 0x20 || byte >= 0x7f)
+            literal << juce::String::formatted ("\\%03o", static_cast<unsigned int> (byte));
+        else
+            literal << juce::String::charToString (byte);
+    }
+
+    return literal + "\"";
+}
+
+static bool compress (const juce::MemoryBlock& source, juce::MemoryOutputStream& destination)
+{
+    juce::GZIPCompressorOutputStream zlib (destination, 9);
+    return zlib.write (source.getData(), source.getSize());
+}
+
+//==============================================================================
+
+int main (int argc, char* argv[])
+{
+    if (argc != 3)
+    {
+        std::cerr << "Usage: PresetPacker <presets folder> <output.cpp>" << std::endl;
+        return 1;
+    }
+
+    const auto currentDirectory = juce::File::getCurrentWorkingDirectory();
+    const auto source = currentDirectory.getChildFile (argv[1]);
+    const auto target = currentDirectory.getChildFile (argv[2]);
+
+    if (!source.isDirectory())
+    {
+        std::cerr << "Not a folder: " << source.getFullPathName() << std::endl;
+        return 1;
+    }
+
+    juce::StringArray relativePaths;
+    for (const auto& file : source.findChildFiles (juce::File::TypesOfFileToFind::findFiles, true, "*.xml"))
+        relativePaths.add (file.getRelativePathFrom (source).replaceCharacter ('\\', '/'));
+
+    if (relativePaths.isEmpty())
+    {
+        std::cerr << "No presets found in " << source.getFullPathName() << std::endl;
+        return 1;
+    }
+
+    // EmbeddedPresets binary searches the table by path, byte-wise
+    std::sort (relativePaths.begin(), relativePaths.end(), [] (const juce::String& a, const juce::String& b)
+    {
+        return std::strcmp (a.toRawUTF8(), b.toRawUTF8()) < 0;
+    });
+
+    juce::MemoryOutputStream blob;
+    juce::MemoryOutputStream entries;
+
+    for (const auto& relativePath : relativePaths)
+    {
+        juce::MemoryBlock presetData;
+        if (!source.getChildFile (relativePath).loadFileAsData (presetData))
+        {
+            std::cerr << "Cannot read " << relativePath << std::endl;
+            return 1;
+        }
+
+        juce::MemoryOutputStream compressed;
+        if (!compress (presetData, compressed))
+        {
+            std::cerr << "Cannot compress " << relativePath << std::endl;
+            return 1;
+        }
+
+        const auto bank = relativePath.containsChar ('/')
+            ? relativePath.upToFirstOccurrenceOf ("/", false, false)
+            : juce::String();
+
+        entries << "    { " << toCppStringLiteral (relativePath)
+                << ", " << toCppStringLiteral (bank)
+                << ", " << juce::String (static_cast<juce::uint64> (blob.getDataSize()))
+                << ", " << juce::String (static_cast<juce::uint64> (compressed.getDataSize()))
+                << ", " << juce::String (static_cast<juce::uint64> (presetData.getSize()))
+                << " },\n";
+
+        blob.write (compressed.getData(), compressed.getDataSize());
+    }
+
+    juce::MemoryOutputStream output;
+    output << "// Generated by tools/PresetPacker from " << source.getFileName() << ". Do not edit.\n\n"
+           << "#include <grape/presets/EmbeddedPresets.h>\n\n"
+           << "namespace grape {\n"
+           << "namespace presets {\n"
+           << "namespace embedded {\n\n"
+           << "static constexpr unsigned char data[] = {";
+
+    const auto bytes = static_cast<const unsigned char*> (blob.getData());
+    for (size_t i = 0; i < blob.getDataSize(); ++i)
+        output << (i % 20 == 0 ? "\n    " : "") << juce::String (static_cast<int> (bytes[i])) << ",";
+
+    output << "\n};\n\n"
+           << "static constexpr EmbeddedPreset presets[] = {\n"
+           << entries.toString()
+           << "};\n\n"
+           << "extern const EmbeddedPresetTable table;\n"
+           << "const EmbeddedPresetTable table { presets, " << relativePaths.size() << ", data };\n\n"
+           << "} // namespace embedded\n"
+           << "} // namespace presets\n"
+           << "} // namespace grape\n";
+
+    if (!target.replaceWithData (output.getData(), output.getDataSize()))
+    {
+        std::cerr << "Cannot write " << target.getFullPathName() << std::endl;
+        return 1;
+    }
+
+    std::cout << "Packed " << relativePaths.size() << " presets ("
+              << blob.getDataSize() << " bytes) into " << target.getFullPathName() << std::endl;
+    return 0;
+}